@@ -95,6 +95,7 @@ namespace MonoUE.Automation
 
 				SC.StageFiles(stageType, dir, name, false, NewPath: OutputDir);
 				SC.StageFiles(stageType, dir, Path.ChangeExtension(name, ".json"), false, bAllowNone: true, NewPath: OutputDir);
+				SC.StageFiles(stageType, dir, Path.ChangeExtension(name, ".metadata"), false, bAllowNone: true, NewPath: OutputDir);
 				if (!Params.NoDebugInfo)
 				{
 					SC.StageFiles(stageType, dir, Path.ChangeExtension(name, ".pdb"), false, bAllowNone: true, NewPath: OutputDir);
@@ -167,7 +167,7 @@ namespace UnrealEngine.Engine
 				IntPtr OverlappingActors_NativeBuffer = IntPtr.Add(ParamsBuffer, GetOverlappingActors_OverlappingActors_Offset);
 				var OverlappingActors_Marshaler = new UnrealArrayCopyMarshaler<T>(1, UnrealObjectMarshaler<T>.ToNative, UnrealObjectMarshaler<T>.FromNative, GetOverlappingActors_OverlappingActors_ElementSize);
 				var overlappingActors = OverlappingActors_Marshaler.FromNative(OverlappingActors_NativeBuffer, 0, null);
-				UnrealArrayCopyMarshaler<T>.DestructInstance(OverlappingActors_NativeBuffer, 0);
+				UnrealArrayCopyMarshaler<T>.DestructNativeInstance(OverlappingActors_NativeBuffer, 0, GetOverlappingActors_OverlappingActors_NativeProperty);
 				return overlappingActors;
 			}
 		}
@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+using UnrealEngine.Runtime;
+
+namespace UnrealEngine.Engine
+{
+    // Spawned for impacts and muzzle flashes and destroyed when they finish, so their wrappers are recycled
+    [PooledWrapper]
+    public partial class ParticleSystemComponent
+    {
+        ~ParticleSystemComponent() { ReturnToWrapperPool(); }
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+using UnrealEngine.Runtime;
+
+namespace UnrealEngine.Engine
+{
+    // Projectiles are spawned and destroyed in bulk, so their movement component wrappers are recycled
+    [PooledWrapper]
+    public partial class ProjectileMovementComponent
+    {
+        ~ProjectileMovementComponent() { ReturnToWrapperPool(); }
+    }
+}
@@ -13,7 +13,7 @@ namespace UnrealEngine.Engine
             get
             {
                 CheckDestroyedByUnrealGC();
-                return BlittableTypeMarshaler<Vector3>.FromNative(IntPtr.Add(NativeObject, RelativeLocation_Offset), 0, this);
+                unsafe { return *(Vector3*)IntPtr.Add(NativeObject, RelativeLocation_Offset).ToPointer(); }
             }
             set
             {
@@ -27,7 +27,7 @@ namespace UnrealEngine.Engine
             get
             {
                 CheckDestroyedByUnrealGC();
-                return BlittableTypeMarshaler<Rotator>.FromNative(IntPtr.Add(NativeObject, RelativeRotation_Offset), 0, this);
+                unsafe { return *(Rotator*)IntPtr.Add(NativeObject, RelativeRotation_Offset).ToPointer(); }
             }
             set
             {
@@ -0,0 +1,13 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+using UnrealEngine.Runtime;
+
+namespace UnrealEngine.MonoRuntime
+{
+    [PooledWrapper]
+    public partial class MonoTestPooledObject
+    {
+        ~MonoTestPooledObject() { ReturnToWrapperPool(); }
+    }
+}
@@ -4,6 +4,7 @@
 using System;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
+using System.Diagnostics;
 using System.Reflection;
 using UnrealEngine.Runtime;
 using UnrealEngine.Engine;
@@ -631,5 +632,59 @@ namespace UnrealEngine.MonoRuntime
             TestUserObject.RunTests();
         }
 
+        // Not picked up by RunTests, this is invoked from the blittable marshaling perf test.
+        public void BenchmarkVectorArrayIteration(int count, int iterations)
+        {
+            IList<OpenTK.Vector3> vectors = TestArrayVector;
+            vectors.Clear();
+            for (int i = 0; i < count; ++i)
+            {
+                vectors.Add(new OpenTK.Vector3(i, i, i));
+            }
+
+            float sum = 0.0f;
+            Stopwatch stopwatch = Stopwatch.StartNew();
+            for (int iteration = 0; iteration < iterations; ++iteration)
+            {
+                foreach (OpenTK.Vector3 vector in vectors)
+                {
+                    sum += vector.X;
+                }
+            }
+            double wrapperTime = stopwatch.Elapsed.TotalMilliseconds;
+
+            unsafe
+            {
+                ScriptArray* nativeArray = (ScriptArray*)IntPtr.Add(NativeObject, TestArrayVector_Offset);
+
+                stopwatch.Restart();
+                for (int iteration = 0; iteration < iterations; ++iteration)
+                {
+                    for (int i = 0; i < nativeArray->ArrayNum; ++i)
+                    {
+                        sum += BlittableTypeMarshaler<OpenTK.Vector3>.FromNative(nativeArray->Data, i, null).X;
+                    }
+                }
+                double marshalerTime = stopwatch.Elapsed.TotalMilliseconds;
+
+                stopwatch.Restart();
+                for (int iteration = 0; iteration < iterations; ++iteration)
+                {
+                    OpenTK.Vector3* data = (OpenTK.Vector3*)nativeArray->Data.ToPointer();
+                    for (int i = 0; i < nativeArray->ArrayNum; ++i)
+                    {
+                        sum += data[i].X;
+                    }
+                }
+                double pointerTime = stopwatch.Elapsed.TotalMilliseconds;
+
+                double elements = (double)count * iterations;
+                Console.WriteLine("Iterating {0} vectors {1} times: UnrealArrayReadWrite {2:F2} ns/element, BlittableTypeMarshaler {3:F2} ns/element, raw pointer {4:F2} ns/element (checksum {5})",
+                    count, iterations, wrapperTime * 1e6 / elements, marshalerTime * 1e6 / elements, pointerTime * 1e6 / elements, sum);
+            }
+
+            vectors.Clear();
+        }
+
     }
 }
\ No newline at end of file
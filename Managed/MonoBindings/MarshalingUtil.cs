@@ -36,31 +36,37 @@ namespace UnrealEngine.Runtime
         }
     }
 
+    // Generated bindings read and write blittable types through typed pointers; this generic path is still
+    // used by rewritten user types and hand-written code.
     public static class BlittableTypeMarshaler<T>
         where T : struct
     {
+        static readonly int ElementSize = Marshal.SizeOf<T>();
+
         public static void ToNative(IntPtr nativeBuffer, int arrayIndex, UnrealObject owner, T obj)
         {
-            Marshal.StructureToPtr<T>(obj, nativeBuffer + arrayIndex * Marshal.SizeOf<T>(), false);
+            Marshal.StructureToPtr<T>(obj, nativeBuffer + arrayIndex * ElementSize, false);
         }
 
         public static T FromNative(IntPtr nativeBuffer, int arrayIndex, UnrealObject owner)
         {
-            return Marshal.PtrToStructure<T>(nativeBuffer + arrayIndex * Marshal.SizeOf<T>());
+            return Marshal.PtrToStructure<T>(nativeBuffer + arrayIndex * ElementSize);
         }
     }
 
     public static class EnumMarshaler<T>
         where T : struct
     {
+        static readonly int ElementSize = Marshal.SizeOf(Enum.GetUnderlyingType(typeof(T)));
+
         public static void ToNative(IntPtr nativeBuffer, int arrayIndex, UnrealObject owner, T obj)
         {
-            Marshal.StructureToPtr<T>(obj, nativeBuffer + arrayIndex * Marshal.SizeOf(Enum.GetUnderlyingType(typeof(T))), false);
+            Marshal.StructureToPtr<T>(obj, nativeBuffer + arrayIndex * ElementSize, false);
         }
 
         public static T FromNative(IntPtr nativeBuffer, int arrayIndex, UnrealObject owner)
         {
-            return Marshal.PtrToStructure<T>(nativeBuffer + arrayIndex * Marshal.SizeOf(Enum.GetUnderlyingType(typeof(T))));
+            return Marshal.PtrToStructure<T>(nativeBuffer + arrayIndex * ElementSize);
         }
     }
 
@@ -47,6 +47,32 @@ namespace UnrealEngine.Runtime
         }
     }
 
+    // Marks a generated bindings class whose IntPtr constructor does nothing but store the native pointer.
+    // The runtime creates wrappers of these classes by writing _NativeObject directly instead of invoking the constructor.
+    // Not inherited: user classes deriving from a bindings class may do work in their own constructors.
+    [AttributeUsage(AttributeTargets.Class, Inherited = false)]
+    public sealed class TrivialWrapperAttribute : Attribute
+    {
+    }
+
+    // Opts a bindings class into wrapper pooling. Unreachable wrappers are recycled for the next object of the class instead of being
+    // collected, which saves an allocation per wrapper for short-lived objects. The class has to declare a finalizer which calls
+    // ReturnToWrapperPool, typically in a partial declaration next to the generated one:
+    //
+    //     [PooledWrapper]
+    //     partial class ProjectileMovementComponent
+    //     {
+    //         ~ProjectileMovementComponent() { ReturnToWrapperPool(); }
+    //     }
+    //
+    // Only classes which are churned through in bulk should opt in. Finalizable objects cost more to allocate and survive an extra
+    // collection, classes deriving from the pooled class inherit the finalizer, and a recycled wrapper is a different object to
+    // anything holding a long weak reference to it.
+    [AttributeUsage(AttributeTargets.Class, Inherited = false)]
+    public sealed class PooledWrapperAttribute : Attribute
+    {
+    }
+
     //If this enum changes AssemblyMetadata.cs and MonoUnrealClass.cpp need updating.
     /// <summary>
     /// Indicates on what level a blueprint can interact with a UClass
@@ -436,6 +436,223 @@ namespace UnrealEngine.Runtime
                 mirror->ArrayNum = 0;
             }
         }
+
+        // Frees a TArray allocated by native code, e.g. a UFunction out param left in the params buffer by InvokeFunction.
+        // The elements are destroyed through the array property, so elements which own memory aren't leaked.
+        public static void DestructNativeInstance(IntPtr nativeBuffer, int arrayIndex, IntPtr nativeProperty)
+        {
+            UnrealArrayOwnedNativeMethods.Free(nativeProperty, nativeBuffer + arrayIndex * Marshal.SizeOf(typeof(ScriptArray)));
+        }
+    }
+
+    class UnrealArrayOwnedNativeMethods
+    {
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealArrayOwned_Insert")]
+        public extern static void Insert(IntPtr scriptArrayPointer, int index, int count, int elementSize);
+
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealArrayOwned_Remove")]
+        public extern static void Remove(IntPtr scriptArrayPointer, int index, int count, int elementSize);
+
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealArrayOwned_Free")]
+        public extern static void Free(IntPtr arrayProperty, IntPtr scriptArrayPointer);
+
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealArrayOwned_Empty")]
+        public extern static void Empty(IntPtr scriptArrayPointer, int elementSize);
+    }
+
+    // Takes ownership of a TArray allocation returned from native code, so out params and return values with
+    // blittable elements are read in place instead of being copied into CoTaskMem and then into a managed list.
+    // The allocation is released through native code on Dispose or finalization. Only blittable elements are held,
+    // so releasing it frees raw memory without going through the array property or running element destructors,
+    // which keeps the finalizer safe on the finalizer thread and after the property's module is gone.
+    public sealed class UnrealArrayOwned<T> : IList<T>, IReadOnlyList<T>, IDisposable
+    {
+        ScriptArray Array;
+        readonly int ElementSize;
+        readonly MarshalingDelegates<T>.ToNative InnerTypeToNative;
+        readonly MarshalingDelegates<T>.FromNative InnerTypeFromNative;
+
+        UnrealArrayOwned(ScriptArray array, MarshalingDelegates<T>.ToNative toNative, MarshalingDelegates<T>.FromNative fromNative, int elementSize)
+        {
+            Array = array;
+            ElementSize = elementSize;
+            InnerTypeToNative = toNative;
+            InnerTypeFromNative = fromNative;
+        }
+
+        ~UnrealArrayOwned()
+        {
+            FreeArray();
+        }
+
+        // Moves the TArray at nativeBuffer into a new owner, leaving an empty array behind.
+        public static UnrealArrayOwned<T> FromNative(IntPtr nativeBuffer, int arrayIndex, MarshalingDelegates<T>.ToNative toNative, MarshalingDelegates<T>.FromNative fromNative, int elementSize)
+        {
+            unsafe
+            {
+                ScriptArray* mirror = (ScriptArray*)(nativeBuffer + arrayIndex * Marshal.SizeOf(typeof(ScriptArray)));
+                UnrealArrayOwned<T> result = new UnrealArrayOwned<T>(*mirror, toNative, fromNative, elementSize);
+                mirror->Data = IntPtr.Zero;
+                mirror->ArrayMax = 0;
+                mirror->ArrayNum = 0;
+                return result;
+            }
+        }
+
+        // Start of the native element storage, valid until the array is resized or disposed.
+        public IntPtr Data
+        {
+            get
+            {
+                return Array.Data;
+            }
+        }
+
+        public int Count
+        {
+            get
+            {
+                return Array.ArrayNum;
+            }
+        }
+
+        public bool IsReadOnly
+        {
+            get
+            {
+                return false;
+            }
+        }
+
+        public T this[int index]
+        {
+            get
+            {
+                CheckIndex(index);
+                return InnerTypeFromNative(Array.Data, index, null);
+            }
+            set
+            {
+                CheckIndex(index);
+                InnerTypeToNative(Array.Data, index, null, value);
+            }
+        }
+
+        public void Add(T item)
+        {
+            Insert(Count, item);
+        }
+
+        public void Insert(int index, T item)
+        {
+            if (index < 0 || index > Count)
+            {
+                throw new IndexOutOfRangeException(string.Format("Index {0} out of bounds. Array is size {1}", index, Count));
+            }
+            unsafe
+            {
+                fixed (ScriptArray* mirror = &Array)
+                {
+                    UnrealArrayOwnedNativeMethods.Insert(new IntPtr(mirror), index, 1, ElementSize);
+                }
+            }
+            InnerTypeToNative(Array.Data, index, null, item);
+        }
+
+        public void RemoveAt(int index)
+        {
+            CheckIndex(index);
+            unsafe
+            {
+                fixed (ScriptArray* mirror = &Array)
+                {
+                    UnrealArrayOwnedNativeMethods.Remove(new IntPtr(mirror), index, 1, ElementSize);
+                }
+            }
+        }
+
+        public bool Remove(T item)
+        {
+            int index = IndexOf(item);
+            if (index < 0)
+            {
+                return false;
+            }
+            RemoveAt(index);
+            return true;
+        }
+
+        public void Clear()
+        {
+            FreeArray();
+        }
+
+        public int IndexOf(T item)
+        {
+            EqualityComparer<T> comparer = EqualityComparer<T>.Default;
+            for (int i = 0; i < Count; ++i)
+            {
+                if (comparer.Equals(InnerTypeFromNative(Array.Data, i, null), item))
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        public bool Contains(T item)
+        {
+            return IndexOf(item) >= 0;
+        }
+
+        public void CopyTo(T[] array, int arrayIndex)
+        {
+            for (int i = 0; i < Count; ++i)
+            {
+                array[arrayIndex + i] = InnerTypeFromNative(Array.Data, i, null);
+            }
+        }
+
+        public IEnumerator<T> GetEnumerator()
+        {
+            for (int i = 0; i < Count; ++i)
+            {
+                yield return InnerTypeFromNative(Array.Data, i, null);
+            }
+        }
+
+        System.Collections.IEnumerator System.Collections.IEnumerable.GetEnumerator()
+        {
+            return GetEnumerator();
+        }
+
+        public void Dispose()
+        {
+            FreeArray();
+            GC.SuppressFinalize(this);
+        }
+
+        void CheckIndex(int index)
+        {
+            if (index < 0 || index >= Count)
+            {
+                throw new IndexOutOfRangeException(string.Format("Index {0} out of bounds. Array is size {1}", index, Count));
+            }
+        }
+
+        void FreeArray()
+        {
+            if (Array.Data != IntPtr.Zero)
+            {
+                unsafe
+                {
+                    fixed (ScriptArray* mirror = &Array)
+                    {
+                        UnrealArrayOwnedNativeMethods.Empty(new IntPtr(mirror), ElementSize);
+                    }
+                }
+            }
+        }
     }
 
 }
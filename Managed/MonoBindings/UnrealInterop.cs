@@ -18,12 +18,26 @@ namespace UnrealEngine.Runtime
 #pragma warning restore 169
         }
 
+        // Mirror struct for FMonoNativePropertyInfo
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NativePropertyInfo
+        {
+            public IntPtr Property;
+            public int Offset;
+            public int ArrayDim;
+            public int ArrayElementSize;
+        }
+
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		extern public static string MarshalIntPtrAsString(IntPtr str);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		extern public static void MarshalToUnrealString(string str, IntPtr scriptArray);
 
+		// Creates a managed string from the FString at nativeString and frees the FString, leaving it empty.
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		extern public static string MoveUnrealStringToManaged(IntPtr nativeString);
+
         // Return a native class pointer from a class name
         [DllImport("__MonoRuntime", EntryPoint = "UnrealInterop_GetNativeClassFromName")]
         extern public static IntPtr GetNativeClassFromName([MarshalAs(UnmanagedType.LPWStr)] string className);
@@ -62,6 +76,26 @@ namespace UnrealEngine.Runtime
                                                     [MarshalAs(UnmanagedType.LPWStr)]
                                                     string propertyName);
 
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealInterop_GetNativePropertyInfos")]
+        extern private static void GetNativePropertyInfos_Native(IntPtr nativeStruct,
+                                                    [MarshalAs(UnmanagedType.LPWStr)]
+                                                    string propertyNames,
+                                                    int count,
+                                                    [Out] NativePropertyInfo[] infos);
+
+        // Looks up offset, property pointer, array dim and array element size for several properties in one native call.
+        // propertyNames is a ';' separated list, and the results are returned in the same order.
+        public static NativePropertyInfo[] GetNativePropertyInfos(IntPtr nativeStruct, string propertyNames, int count)
+        {
+            NativePropertyInfo[] infos = new NativePropertyInfo[count];
+            GetNativePropertyInfos_Native(nativeStruct, propertyNames, count, infos);
+            return infos;
+        }
+
+        // Checks the layout hash baked into a generated bindings module against the running build.
+        [DllImport("__MonoRuntime", EntryPoint = "UnrealInterop_ValidateBakedLayout"), CLSCompliant(false)]
+        extern public static bool ValidateBakedLayout([MarshalAs(UnmanagedType.LPWStr)] string moduleName, uint expectedHash);
+
         [DllImport("__MonoRuntime", EntryPoint = "UnrealInterop_GetBitfieldValueFromProperty"), CLSCompliant(false)]
         extern public static bool GetBitfieldValueFromProperty(IntPtr nativeObject, IntPtr nativeProperty, int offset);
 
@@ -89,6 +89,17 @@ namespace UnrealEngine.Runtime
             _NativeObject = initializer.NativeObject;
         }
 
+        // Called from the finalizer of classes marked [PooledWrapper]. The wrapper is handed back to the native wrapper pool
+        // and reused for the next object of the same class, the pool re-targets _NativeObject before handing it out again.
+        protected void ReturnToWrapperPool()
+        {
+            _NativeObject = IntPtr.Zero;
+            if (ReturnWrapperToPoolNative(this))
+            {
+                GC.ReRegisterForFinalize(this);
+            }
+        }
+
         public override bool Equals(object obj)
         {
             UnrealObject other = obj as UnrealObject;
@@ -115,11 +126,19 @@ namespace UnrealEngine.Runtime
         }
 
         // Native callbacks
-        void ClearNativePointer()
+        static void ClearNativePointers(IntPtr[] handles, int count)
         {
             // Certain types of unreal objects can be deleted when references still exist to them, such as Actor and Component
             // clear out our native pointer when this happens
-            _NativeObject = IntPtr.Zero;
+            // The native object table batches these up, handles belong to it and are freed once we return
+            for (int i = 0; i < count; ++i)
+            {
+                UnrealObject obj = (UnrealObject)GCHandle.FromIntPtr(handles[i]).Target;
+                if (obj != null)
+                {
+                    obj._NativeObject = IntPtr.Zero;
+                }
+            }
         }
 
         public static T GetUnrealObjectWrapper<T>(IntPtr nativePointer) where T : UnrealObject
@@ -257,6 +276,9 @@ namespace UnrealEngine.Runtime
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         private extern static UnrealObject GetUnrealObjectWrapperNative(IntPtr nativePointer);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        private extern static bool ReturnWrapperToPoolNative(UnrealObject wrapper);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         private extern static UnrealObject ConstructUnrealObjectNative(Type unrealType, IntPtr nativeClass, IntPtr nativeOuter, Name objectName, ObjectFlags flags, IntPtr nativeTemplate, bool copyTransientsFromClassDefaults, IntPtr instanceGraph, bool assumeTemplateIsArchetype);
 
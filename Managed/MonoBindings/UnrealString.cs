@@ -59,6 +59,12 @@ namespace UnrealEngine.Runtime
             }
         }
 
+        // Used for UFunction out params and return values, which InvokeFunction leaves in the buffer as live FStrings.
+        public static string MoveFromNative(IntPtr nativeBuffer, int arrayIndex)
+        {
+            return UnrealInterop.MoveUnrealStringToManaged(nativeBuffer + arrayIndex * Marshal.SizeOf(typeof(ScriptArray)));
+        }
+
         public static void DestructInstance (IntPtr nativeBuffer, int arrayIndex)
         {
             unsafe
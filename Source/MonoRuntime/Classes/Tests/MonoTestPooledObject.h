@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Object.h"
+#include "MonoTestPooledObject.generated.h"
+
+// Its wrapper class opts into wrapper pooling in MonoTestPooledObject_Injected.cs
+UCLASS()
+class UMonoTestPooledObject : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Test")
+		int32 TestReadableInt32;
+
+};
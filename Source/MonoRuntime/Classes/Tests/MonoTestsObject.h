@@ -91,6 +91,23 @@ struct FMonoTestsStruct
 		TWeakObjectPtr<UObject> TestStructWeakObject;
 };
 
+// Element type which owns memory, counts its destructions so tests can tell whether array elements were destroyed
+USTRUCT()
+struct FMonoTestsStringStruct
+{
+	GENERATED_USTRUCT_BODY()
+
+	~FMonoTestsStringStruct()
+	{
+		++NumDestroyed;
+	}
+
+	UPROPERTY()
+		FString TestString;
+
+	static int32 NumDestroyed;
+};
+
 UCLASS(BlueprintType)
 class UMonoTestsObject : public UObject
 {
@@ -151,6 +168,8 @@ public:
 		TArray<int32> TestArrayInt;
 	UPROPERTY(BlueprintReadWrite, Category = "Test")
 		TArray<float> TestArrayFloat;
+	UPROPERTY(BlueprintReadWrite, Category = "Test")
+		TArray<FVector> TestArrayVector;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Test")
 		FVector2D TestReadableVector2D;
@@ -173,6 +192,9 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Test")
 		TArray<FMonoTestsStruct> TestReadWriteStructArray;
 
+	UPROPERTY()
+		TArray<FMonoTestsStringStruct> TestStringStructArray;
+
 	UPROPERTY(BlueprintReadWrite, Category = "Test")
 		UClass* TestReadWriteClass;
 	UPROPERTY(BlueprintReadWrite, Category = "Test")
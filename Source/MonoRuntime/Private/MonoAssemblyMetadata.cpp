@@ -11,12 +11,26 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
 
 #include "MonoBindings.h"
 #include "MonoRuntimeCommon.h"
+#include "MonoRuntimePrivate.h"
 
 #define LOCTEXT_NAMESPACE "MonoRuntime"
 
+DECLARE_CYCLE_STAT(TEXT("Load Assembly Metadata"), STAT_MonoLoadAssemblyMetadata, STATGROUP_Mono);
+DECLARE_CYCLE_STAT(TEXT("Load Assembly Metadata In Directory"), STAT_MonoLoadAssemblyMetadataInDirectory, STATGROUP_Mono);
+
+static int32 GMonoParallelMetadataLoad = 1;
+static FAutoConsoleVariableRef CVarMonoParallelMetadataLoad(
+	TEXT("MonoRuntime.ParallelMetadataLoad"),
+	GMonoParallelMetadataLoad,
+	TEXT("If non-zero, assembly metadata files are read and parsed in parallel on the task graph at startup and hot reload."),
+	ECVF_Default);
+
 #define JSON_READ_BOOL(MemberName) \
 	if(!ReadBoolFieldChecked(MemberName, ErrorMessage, Object, FString( "" #MemberName ))) \
 	{ \
@@ -613,42 +627,682 @@ bool FMonoAssemblyMetadata::ParseFromJsonObject(FString& ErrorMessage, const FJs
 #undef JSON_PARSE_OBJECT
 #undef JSON_PARSE_OBJECT_ARRAY
 
-bool FMonoLoadedAssemblyMetadata::LoadAssemblyMetadataInDirectory(TArray<FMonoLoadedAssemblyMetadata>& Loaded, const FString& InDirectory)
+// Reads the .metadata files MonoAssemblyProcess writes next to the json (see BinaryMetadataWriter.cs, keep the two in sync).
+// Every string is stored once in a table at the start and fields refer to it by index, so there's no tokenizing or DOM
+// building and each distinct string is only converted once. Records are laid out in the same order the json parsers read fields.
+class FMonoMetadataBinaryReader
 {
-	bool bAnyFailed = false;
-	TArray<FString> MetadataFiles;
-	IFileManager::Get().FindFiles(MetadataFiles, *FPaths::Combine(*InDirectory, TEXT("*.json")), true, false);
+public:
+	static const uint32 Magic = 0x4D45554D; // "MUEM"
+	static const uint32 Version = 3;
+
+	explicit FMonoMetadataBinaryReader(const TArray<uint8>& InData)
+		: Data(InData.GetData())
+		, DataSize(InData.Num())
+		, Offset(0)
+	{
+	}
 
-	for (const FString& MetadataFileName : MetadataFiles)
+	bool ReadHeader(FString& ErrorMessage)
 	{
-		const FString MetadataFile = FPaths::Combine(*InDirectory, *MetadataFileName);
-		const FString AssemblyFile = FPaths::GetBaseFilename(MetadataFile, false) + TEXT(".dll");
+		uint32 FileMagic = 0;
+		if (!ReadRaw(FileMagic) || FileMagic != Magic)
+		{
+			ErrorMessage = TEXT("Not a binary assembly metadata file");
+			return false;
+		}
 
-		if (FPaths::FileExists(*AssemblyFile))
+		uint32 FileVersion = 0;
+		if (!ReadRaw(FileVersion) || FileVersion != Version)
 		{
-			FGuid ScriptPackageGuid;
-			TSharedPtr<FMonoAssemblyMetadata> Metadata = LoadAssemblyMetadata(ScriptPackageGuid, MetadataFile);
+			ErrorMessage = FString::Printf(TEXT("Binary assembly metadata version %u is not supported, expected %u"), FileVersion, Version);
+			return false;
+		}
 
-			if (Metadata.IsValid())
+		int32 NumStrings;
+		if (!ReadCount(NumStrings, ErrorMessage, TEXT("Strings")))
+		{
+			return false;
+		}
+
+		Strings.Empty(NumStrings);
+		Names.Init(NAME_None, NumStrings);
+		NameCached.Init(false, NumStrings);
+
+		TArray<UTF16CHAR> Chars;
+		for (int32 StringIndex = 0; StringIndex < NumStrings; ++StringIndex)
+		{
+			int32 Length;
+			if (!ReadRaw(Length) || Length < 0 || Length > (DataSize - Offset) / (int32)sizeof(UTF16CHAR))
 			{
-				FMonoLoadedAssemblyMetadata LoadedAssemblyMetadata;
-				LoadedAssemblyMetadata.AssemblyFile = AssemblyFile;
-				LoadedAssemblyMetadata.MetadataFile = MetadataFile;
-				LoadedAssemblyMetadata.AssemblyMetadata = Metadata;
-				LoadedAssemblyMetadata.ScriptPackageGuid = ScriptPackageGuid;
-				Loaded.Add(LoadedAssemblyMetadata);
+				ErrorMessage = TEXT("Binary assembly metadata string table is truncated");
+				return false;
 			}
-			else
+
+			// string data isn't guaranteed to be aligned, so copy it out before converting
+			Chars.SetNumUninitialized(Length, false);
+			FMemory::Memcpy(Chars.GetData(), Data + Offset, Length * sizeof(UTF16CHAR));
+			Offset += Length * sizeof(UTF16CHAR);
+
+			auto Converted = StringCast<TCHAR>(Chars.GetData(), Length);
+			Strings.Emplace(Converted.Length(), Converted.Get());
+		}
+
+		return true;
+	}
+
+	bool IsAtEnd() const
+	{
+		return Offset == DataSize;
+	}
+
+	bool ReadBool(bool& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		uint8 Value;
+		if (!ReadByte(Value, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+		Dest = Value != 0;
+		return true;
+	}
+
+	bool ReadByte(uint8& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		return CheckRead(ReadRaw(Dest), ErrorMessage, FieldName);
+	}
+
+	bool ReadInt(int32& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		return CheckRead(ReadRaw(Dest), ErrorMessage, FieldName);
+	}
+
+	// Array lengths. Every element takes at least a byte, which bounds the count for corrupt files before anything is allocated.
+	bool ReadCount(int32& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		return CheckRead(ReadRaw(Dest) && Dest >= 0 && Dest <= DataSize - Offset, ErrorMessage, FieldName);
+	}
+
+	bool ReadString(FString& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		int32 StringIndex;
+		if (!ReadRequiredStringIndex(StringIndex, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+		Dest = Strings[StringIndex];
+		return true;
+	}
+
+	bool ReadString(FName& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		int32 StringIndex;
+		if (!ReadRequiredStringIndex(StringIndex, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+		Dest = GetName(StringIndex);
+		return true;
+	}
+
+	// Leaves Dest alone if the string was null, only fails on a malformed file
+	bool ReadOptionalString(FName& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		int32 StringIndex;
+		if (!ReadStringIndex(StringIndex, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+		if (StringIndex != INDEX_NONE)
+		{
+			Dest = GetName(StringIndex);
+		}
+		return true;
+	}
+
+	bool ReadStringArray(TArray<FString>& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		int32 Count;
+		if (!ReadCount(Count, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+
+		Dest.Empty(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			if (!ReadString(Dest[Dest.AddDefaulted()], ErrorMessage, FieldName))
 			{
-				bAnyFailed = true;
+				return false;
 			}
 		}
+		return true;
+	}
+
+private:
+	template <class T>
+	bool ReadRaw(T& Dest)
+	{
+		if (Offset + (int32)sizeof(T) > DataSize)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Dest, Data + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+
+	static bool CheckRead(bool bSucceeded, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		if (!bSucceeded)
+		{
+			ErrorMessage = FString::Printf(TEXT("Binary assembly metadata is truncated or corrupt at field %s"), FieldName);
+		}
+		return bSucceeded;
+	}
+
+	bool ReadStringIndex(int32& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		return CheckRead(ReadRaw(Dest) && Dest >= INDEX_NONE && Dest < Strings.Num(), ErrorMessage, FieldName);
+	}
+
+	bool ReadRequiredStringIndex(int32& Dest, FString& ErrorMessage, const TCHAR* FieldName)
+	{
+		if (!ReadStringIndex(Dest, ErrorMessage, FieldName))
+		{
+			return false;
+		}
+		if (Dest == INDEX_NONE)
+		{
+			ErrorMessage = FString::Printf(TEXT("Assembly metadata missing field %s"), FieldName);
+			return false;
+		}
+		return true;
+	}
+
+	FName GetName(int32 StringIndex)
+	{
+		if (!NameCached[StringIndex])
+		{
+			Names[StringIndex] = FName(*Strings[StringIndex]);
+			NameCached[StringIndex] = true;
+		}
+		return Names[StringIndex];
+	}
+
+	const uint8* Data;
+	int32 DataSize;
+	int32 Offset;
+	TArray<FString> Strings;
+	TArray<FName> Names;
+	TBitArray<> NameCached;
+};
+
+#define BINARY_READ_BOOL(MemberName) \
+	if(!Reader.ReadBool(MemberName, ErrorMessage, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_READ_INT(MemberName) \
+	if(!Reader.ReadInt(MemberName, ErrorMessage, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_READ_STRING(MemberName) \
+	if(!Reader.ReadString(MemberName, ErrorMessage, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_READ_OPTIONAL_STRING(MemberName) \
+	if(!Reader.ReadOptionalString(MemberName, ErrorMessage, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_READ_STRING_ARRAY(MemberName) \
+	if(!Reader.ReadStringArray(MemberName, ErrorMessage, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_PARSE_OBJECT(MemberName) \
+	if(!ParseBinaryObject(MemberName, ErrorMessage, Reader)) \
+	{ \
+		return false; \
+	}
+
+#define BINARY_PARSE_OBJECT_ARRAY(MemberName) \
+	if(!ParseBinaryObjectArray(MemberName, ErrorMessage, Reader, TEXT(#MemberName))) \
+	{ \
+		return false; \
+	}
+
+template <class T>
+static bool ParseBinaryObject(T& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	return Dest.ParseFromBinary(ErrorMessage, Reader);
+}
+
+template <class T>
+static bool ParseBinaryObject(TUniquePtr<T>& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	return T::ParseDerivedFromBinary(Dest, ErrorMessage, Reader);
+}
+
+template <class T>
+static bool ParseBinaryObjectArray(TArray<T>& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader, const TCHAR* FieldName)
+{
+	int32 Count;
+	if (!Reader.ReadCount(Count, ErrorMessage, FieldName))
+	{
+		return false;
+	}
+
+	Dest.Empty(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		T& NewDest = *(new(Dest) T);
+
+		if (!NewDest.ParseFromBinary(ErrorMessage, Reader))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool ReadFlagsString(uint64& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	FString Flags;
+	BINARY_READ_STRING(Flags);
+	TTypeFromString<uint64>::FromString(Dest, *Flags);
+	return true;
+}
+
+bool FMonoKeyValuePair::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	BINARY_READ_STRING(Key);
+	BINARY_READ_STRING(Value);
+
+	return true;
+}
+
+bool FMonoUnrealType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	// UnrealPropertyClass was already read by ParseDerivedFromBinary to pick the type
+	BINARY_READ_INT(ArrayDim);
+	return true;
+}
+
+bool FMonoUnrealType::ParseDerivedFromBinary(TUniquePtr<FMonoUnrealType>& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	FName UnrealPropertyClass;
+	BINARY_READ_STRING(UnrealPropertyClass);
+
+	static const FName EnumPropertyName("EnumProperty");
+	static const FName CoreStructPropertyName("CoreStructProperty");
+
+	if (UnrealPropertyClass == EnumPropertyName)
+	{
+		Dest.Reset(new FMonoUnrealEnumType);
+	}
+	else if (UnrealPropertyClass == CoreStructPropertyName)
+	{
+		Dest.Reset(new FMonoCoreStructType);
+	}
+	else if (UnrealPropertyClass == UStructProperty::StaticClass()->GetFName())
+	{
+		Dest.Reset(new FMonoStructType);
+	}
+	else if (UnrealPropertyClass == UObjectProperty::StaticClass()->GetFName())
+	{
+		Dest.Reset(new FMonoUnrealObjectType);
+	}
+	else if (UnrealPropertyClass == UClassProperty::StaticClass()->GetFName())
+	{
+		Dest.Reset(new FMonoUnrealClassType);
+	}
+	else if (UnrealPropertyClass == UWeakObjectProperty::StaticClass()->GetFName())
+	{
+		Dest.Reset(new FMonoUnrealWeakObjectType);
+	}
+	else if (UnrealPropertyClass == UArrayProperty::StaticClass()->GetFName())
+	{
+		Dest.Reset(new FMonoUnrealArrayType);
+	}
+	else
+	{
+		Dest.Reset(new FMonoUnrealType);
+	}
+
+	Dest->UnrealPropertyClass = UnrealPropertyClass;
+	return Dest->ParseFromBinary(ErrorMessage, Reader);
+}
+
+bool FMonoCoreStructType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_READ_STRING(StructName);
+	return true;
+}
+
+bool FMonoStructType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_READ_STRING(NativeClassOwner);
+	BINARY_PARSE_OBJECT(TypeRef);
+	return true;
+}
+
+bool FMonoUnrealEnumType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_READ_STRING(NativeClassOwner);
+	BINARY_READ_STRING(NativeEnumName);
+	BINARY_PARSE_OBJECT(TypeRef);
+	return true;
+}
+
+bool FMonoUnrealObjectType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_PARSE_OBJECT(TypeRef);
+
+	return true;
+}
+
+bool FMonoUnrealClassType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_PARSE_OBJECT(TypeRef);
+
+	return true;
+}
+
+bool FMonoUnrealWeakObjectType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+	BINARY_PARSE_OBJECT(TypeRef);
+
+	return true;
+}
+
+bool FMonoUnrealArrayType::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoUnrealType::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_PARSE_OBJECT(InnerProperty);
+
+	return true;
+}
+
+bool FMonoMetadataBase::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!Reader.ReadString(NameCaseSensitive, ErrorMessage, TEXT("Name")))
+	{
+		return false;
+	}
+	Name = static_cast<FName>(*NameCaseSensitive);
+
+	uint8 RawProtection;
+	if (!Reader.ReadByte(RawProtection, ErrorMessage, TEXT("Protection")))
+	{
+		return false;
+	}
+	if (RawProtection > (uint8)EMonoAccessModifier::Public)
+	{
+		ErrorMessage = FString::Printf(TEXT("Unknown property protection type %d"), RawProtection);
+		return false;
+	}
+	Protection = (EMonoAccessModifier)RawProtection;
+
+#if WITH_METADATA
+	BINARY_PARSE_OBJECT_ARRAY(Metadata);
+#else
+	// always written, so it still has to be stepped over
+	TArray<FMonoKeyValuePair> Metadata;
+	BINARY_PARSE_OBJECT_ARRAY(Metadata);
+#endif // WITH_METADATA
+
+	return true;
+}
+
+bool FMonoPropertyMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoMetadataBase::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_PARSE_OBJECT(UnrealPropertyType);
+
+	uint64 UintPropertyFlags;
+	if (!ReadFlagsString(UintPropertyFlags, ErrorMessage, Reader))
+	{
+		return false;
+	}
+	PropertyFlags = (EPropertyFlags)UintPropertyFlags;
+
+	BINARY_READ_OPTIONAL_STRING(RepNotifyFunctionName);
+
+	return true;
+}
+
+bool FMonoFunctionMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoMetadataBase::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	// Return value might be null, for void functions.
+	bool bHasReturnValue;
+	BINARY_READ_BOOL(bHasReturnValue);
+	if (bHasReturnValue)
+	{
+		BINARY_PARSE_OBJECT(ReturnValueProperty);
+	}
+
+	BINARY_PARSE_OBJECT_ARRAY(ParamProperties);
+
+	uint64 UintFunctionFlags;
+	if (!ReadFlagsString(UintFunctionFlags, ErrorMessage, Reader))
+	{
+		return false;
+	}
+	FunctionFlags = (EFunctionFlags)UintFunctionFlags;
+
+	return true;
+}
+
+bool FMonoEnumMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoTypeReferenceMetadata::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_READ_STRING_ARRAY(Items);
+	BINARY_READ_STRING(EnumHash);
+	BINARY_READ_BOOL(BlueprintVisible);
+	return true;
+}
+
+bool FMonoTypeReferenceMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	BINARY_READ_STRING(Namespace);
+	BINARY_READ_STRING(Name);
+	BINARY_READ_STRING(AssemblyName);
+
+	return true;
+}
+
+bool FMonoClassMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoTypeReferenceMetadata::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_READ_STRING_ARRAY(VirtualFunctions);
+
+	BINARY_PARSE_OBJECT_ARRAY(Properties);
+	BINARY_PARSE_OBJECT_ARRAY(Functions);
+
+	BINARY_PARSE_OBJECT(BaseClass);
+	BINARY_PARSE_OBJECT(BaseUnrealNativeClass);
+
+	BINARY_READ_BOOL(ChildCanTick);
+	BINARY_READ_BOOL(OverridesBindInput);
+	BINARY_READ_STRING(ClassHash);
+
+	BINARY_READ_STRING(BlueprintUse);
+	BINARY_READ_STRING(Transience);
+	BINARY_READ_STRING(Placeablity);
+	BINARY_READ_BOOL(Deprecated);
+	BINARY_READ_BOOL(Abstract);
+	BINARY_READ_STRING(Group);
+	BINARY_READ_STRING(ConfigFile);
+	BINARY_READ_STRING(Flags);
+	TTypeFromString<uint64>::FromString(ClassFlags, *Flags);
+
+	return true;
+}
+
+bool FMonoStructMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	if (!FMonoTypeReferenceMetadata::ParseFromBinary(ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_PARSE_OBJECT_ARRAY(Properties);
+
+	if (!ReadFlagsString(StructFlags, ErrorMessage, Reader))
+	{
+		return false;
+	}
+
+	BINARY_READ_STRING(StructHash);
+
+	return true;
+}
+
+bool FMonoAssemblyReferenceMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	BINARY_READ_STRING(AssemblyName);
+	BINARY_READ_STRING(AssemblyPath);
+	BINARY_READ_BOOL(Resolved);
+	BINARY_READ_BOOL(InKnownLocation);
+
+	return true;
+}
+
+bool FMonoAssemblyMetadata::ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader)
+{
+	BINARY_READ_STRING(AssemblyName);
+	BINARY_READ_STRING(AssemblyPath);
+
+	BINARY_PARSE_OBJECT_ARRAY(References);
+
+	BINARY_PARSE_OBJECT_ARRAY(Structs);
+	BINARY_PARSE_OBJECT_ARRAY(Classes);
+	BINARY_PARSE_OBJECT_ARRAY(Enums);
+
+	return true;
+}
+
+#undef BINARY_READ_BOOL
+#undef BINARY_READ_INT
+#undef BINARY_READ_STRING
+#undef BINARY_READ_OPTIONAL_STRING
+#undef BINARY_READ_STRING_ARRAY
+#undef BINARY_PARSE_OBJECT
+#undef BINARY_PARSE_OBJECT_ARRAY
+
+bool FMonoLoadedAssemblyMetadata::LoadAssemblyMetadataInDirectory(TArray<FMonoLoadedAssemblyMetadata>& Loaded, const FString& InDirectory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MonoLoadAssemblyMetadataInDirectory);
+
+	TArray<FString> MetadataFiles;
+	IFileManager::Get().FindFiles(MetadataFiles, *FPaths::Combine(*InDirectory, TEXT("*.json")), true, false);
+
+	struct FPendingLoad
+	{
+		FString MetadataFile;
+		FString AssemblyFile;
+		FGuid ScriptPackageGuid;
+		TSharedPtr<FMonoAssemblyMetadata> Metadata;
+		TArray<FText> Errors;
+	};
+
+	TArray<FPendingLoad> PendingLoads;
+	PendingLoads.SetNum(MetadataFiles.Num());
+
+	// Each file is read and parsed independently, so spread them over the task graph. The message log isn't thread safe,
+	// so errors are collected per file and reported below in directory order, same as a serial load would.
+	ParallelFor(MetadataFiles.Num(), [&MetadataFiles, &PendingLoads, &InDirectory](int32 Index)
+	{
+		FPendingLoad& Pending = PendingLoads[Index];
+		Pending.MetadataFile = FPaths::Combine(*InDirectory, *MetadataFiles[Index]);
+		Pending.AssemblyFile = FPaths::GetBaseFilename(Pending.MetadataFile, false) + TEXT(".dll");
+
+		if (FPaths::FileExists(*Pending.AssemblyFile))
+		{
+			Pending.Metadata = LoadAssemblyMetadata(Pending.ScriptPackageGuid, Pending.Errors, Pending.MetadataFile);
+		}
 		else
 		{
 			FFormatNamedArguments Args;
-			Args.Add(TEXT("MetadataFile"), FText::FromString(MetadataFile));
-			Args.Add(TEXT("AssemblyFile"), FText::FromString(AssemblyFile));
-			FMessageLog(NAME_MonoErrors).Error(FText::Format(LOCTEXT("NoGameAssemblyFound", "Found game assembly metadata file '{MetadataFile}' but no assembly '{AssemblyFile}'"), Args));
+			Args.Add(TEXT("MetadataFile"), FText::FromString(Pending.MetadataFile));
+			Args.Add(TEXT("AssemblyFile"), FText::FromString(Pending.AssemblyFile));
+			Pending.Errors.Add(FText::Format(LOCTEXT("NoGameAssemblyFound", "Found game assembly metadata file '{MetadataFile}' but no assembly '{AssemblyFile}'"), Args));
+		}
+	}, GMonoParallelMetadataLoad == 0);
+
+	bool bAnyFailed = false;
+	for (FPendingLoad& Pending : PendingLoads)
+	{
+		for (const FText& Error : Pending.Errors)
+		{
+			FMessageLog(NAME_MonoErrors).Error(Error);
+		}
+
+		if (Pending.Metadata.IsValid())
+		{
+			FMonoLoadedAssemblyMetadata LoadedAssemblyMetadata;
+			LoadedAssemblyMetadata.AssemblyFile = MoveTemp(Pending.AssemblyFile);
+			LoadedAssemblyMetadata.MetadataFile = MoveTemp(Pending.MetadataFile);
+			LoadedAssemblyMetadata.AssemblyMetadata = Pending.Metadata;
+			LoadedAssemblyMetadata.ScriptPackageGuid = Pending.ScriptPackageGuid;
+			Loaded.Add(LoadedAssemblyMetadata);
+		}
+		else
+		{
 			bAnyFailed = true;
 		}
 	}
@@ -656,7 +1310,48 @@ bool FMonoLoadedAssemblyMetadata::LoadAssemblyMetadataInDirectory(TArray<FMonoLo
 	return !bAnyFailed;
 }
 
-TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadAssemblyMetadata(FGuid& ScriptPackageGuid, const FString& MetadataFile)
+TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadAssemblyMetadata(FGuid& ScriptPackageGuid, TArray<FText>& OutErrors, const FString& MetadataFile)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MonoLoadAssemblyMetadata);
+
+	TSharedPtr<FMonoAssemblyMetadata> Metadata = LoadBinaryAssemblyMetadata(ScriptPackageGuid, MetadataFile);
+	if (!Metadata.IsValid())
+	{
+		Metadata = LoadJsonAssemblyMetadata(ScriptPackageGuid, OutErrors, MetadataFile);
+		if (!Metadata.IsValid())
+		{
+			return TSharedPtr<FMonoAssemblyMetadata>();
+		}
+	}
+
+	FString CleanMetadataFile(FPaths::GetCleanFilename(MetadataFile));
+
+	// Metadata verification
+	// Make sure all assembly references are either system references, or bindings references, and were resolved correctly. We don't yet support class libs referencing other class libs, 
+	// or general references to non-class lib assemblies. (This is a TODO)
+	bool bFailedResolve = false;
+
+	for (const auto& Reference : Metadata->References)
+	{
+		if (!Reference.Resolved)
+		{
+			FFormatNamedArguments Args;
+			Args.Add(TEXT("CleanMetadataFile"), FText::FromString(CleanMetadataFile));
+			Args.Add(TEXT("AssemblyName"), FText::FromString(Reference.AssemblyName));
+			OutErrors.Add(FText::Format(LOCTEXT("CouldNotResolveAssembly", "'{CleanMetadataFile}': Assembly reference '{AssemblyName}' could not be resolved."), Args));
+			bFailedResolve = true;
+		}
+	}
+
+	if (bFailedResolve)
+	{
+		return TSharedPtr<FMonoAssemblyMetadata>();
+	}
+
+	return Metadata;
+}
+
+TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadJsonAssemblyMetadata(FGuid& ScriptPackageGuid, TArray<FText>& OutErrors, const FString& MetadataFile)
 {
 	FString CleanMetadataFile(FPaths::GetCleanFilename(MetadataFile));
 
@@ -665,7 +1360,7 @@ TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadAssemblyMetad
 	{
 		FFormatNamedArguments Args;
 		Args.Add(TEXT("MetadataFile"), FText::FromString(MetadataFile));
-		FMessageLog(NAME_MonoErrors).Error(FText::Format(LOCTEXT("CouldNotLoadMetadata", "Could not load game assembly metadata file '{MetadataFile}'"), Args));
+		OutErrors.Add(FText::Format(LOCTEXT("CouldNotLoadMetadata", "Could not load game assembly metadata file '{MetadataFile}'"), Args));
 		return TSharedPtr<FMonoAssemblyMetadata>();
 	}
 
@@ -675,7 +1370,7 @@ TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadAssemblyMetad
 	{
 		FFormatNamedArguments Args;
 		Args.Add(TEXT("CleanMetadataFile"), FText::FromString(CleanMetadataFile));
-		FMessageLog(NAME_MonoErrors).Error(FText::Format(LOCTEXT("CouldNotParseMetadata", "Could not parse metadata file '{CleanMetadataFile}'"), Args));
+		OutErrors.Add(FText::Format(LOCTEXT("CouldNotParseMetadata", "Could not parse metadata file '{CleanMetadataFile}'"), Args));
 		return TSharedPtr<FMonoAssemblyMetadata>();
 	}
 
@@ -687,39 +1382,77 @@ TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadAssemblyMetad
 		FFormatNamedArguments Args;
 		Args.Add(TEXT("CleanMetadataFile"), FText::FromString(CleanMetadataFile));
 		Args.Add(TEXT("ErrorMessage"), FText::FromString(ErrorMessage));
-		FMessageLog(NAME_MonoErrors).Error(FText::Format(LOCTEXT("ErrorParsingMetadata", "Error parsing metadata file '{CleanMetadataFile}': '{ErrorMessage}'"), Args));
+		OutErrors.Add(FText::Format(LOCTEXT("ErrorParsingMetadata", "Error parsing metadata file '{CleanMetadataFile}': '{ErrorMessage}'"), Args));
 		return TSharedPtr<FMonoAssemblyMetadata>();
 	}
 
-	// Metadata verification
-	// Make sure all assembly references are either system references, or bindings references, and were resolved correctly. We don't yet support class libs referencing other class libs, 
-	// or general references to non-class lib assemblies. (This is a TODO)
-	bool bFailedResolve = false;
+	ScriptPackageGuid = HashMetadataJson(MetadataJsonString);
 
-	for (const auto& Reference : Metadata->References)
+	return Metadata;
+}
+
+FGuid FMonoLoadedAssemblyMetadata::HashMetadataJson(const FString& MetadataJsonString)
+{
+	// generate a package guid from a hash of the manifest file
+	// I'm not sure how globally unique this actually is, but this mirrors what Epic does for script packages in the code generator
+	// we use MD5 because it has a hash size of 16 bytes, which fits in a guid
+	// Packages are saved with this guid, so the bytes hashed must not change: TCHARs (4 bytes on Linux and Mac) after the locale's ToUpper
+	FString UpperCaseMetadataText = MetadataJsonString.ToUpper();
+	FGuid Guid;
+	FMD5 Hash;
+	Hash.Update(reinterpret_cast<uint8*>(UpperCaseMetadataText.GetCharArray().GetData()), UpperCaseMetadataText.Len()*sizeof(TCHAR));
+	Hash.Final(reinterpret_cast<uint8*>(&Guid));
+	return Guid;
+}
+
+TSharedPtr<FMonoAssemblyMetadata> FMonoLoadedAssemblyMetadata::LoadBinaryAssemblyMetadata(FGuid& ScriptPackageGuid, const FString& MetadataFile)
+{
+	const FString BinaryMetadataFile = FPaths::GetBaseFilename(MetadataFile, false) + TEXT(".metadata");
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FDateTime BinaryTimeStamp = FileManager.GetTimeStamp(*BinaryMetadataFile);
+	if (BinaryTimeStamp == FDateTime::MinValue())
 	{
-		if (!Reference.Resolved)
-		{
-			FFormatNamedArguments Args;
-			Args.Add(TEXT("CleanMetadataFile"), FText::FromString(CleanMetadataFile));
-			Args.Add(TEXT("AssemblyName"), FText::FromString(Reference.AssemblyName));
-			FMessageLog(NAME_MonoErrors).Error(FText::Format(LOCTEXT("CouldNotResolveAssembly", "'{CleanMetadataFile}': Assembly reference '{AssemblyName}' could not be resolved."), Args));
-			bFailedResolve = true;
-		}
+		return TSharedPtr<FMonoAssemblyMetadata>();
 	}
 
-	if (bFailedResolve)
+	// MonoAssemblyProcess always writes the binary after the json, so an older one is left over from a previous build
+	if (BinaryTimeStamp < FileManager.GetTimeStamp(*MetadataFile))
 	{
+		UE_LOG(LogMono, Log, TEXT("Ignoring out of date binary assembly metadata '%s'"), *BinaryMetadataFile);
 		return TSharedPtr<FMonoAssemblyMetadata>();
 	}
 
-	// generate a package guid from a hash of the manifest file
-	// I'm not sure how globally unique this actually is, but this mirrors what Epic does for script packages in the code generator
-	// we use MD5 because it has a hash size of 16 bytes, which fits in a guid
-	FString UpperCaseMetadataText = MetadataJsonString.ToUpper();
-	FMD5  Hash;
-	Hash.Update(reinterpret_cast<uint8*>(UpperCaseMetadataText.GetCharArray().GetData()), UpperCaseMetadataText.Len()*sizeof(TCHAR));
-	Hash.Final(reinterpret_cast<uint8*>(&ScriptPackageGuid));
+	TArray<uint8> BinaryData;
+	if (!FFileHelper::LoadFileToArray(BinaryData, *BinaryMetadataFile))
+	{
+		UE_LOG(LogMono, Warning, TEXT("Could not load binary assembly metadata '%s', falling back to json"), *BinaryMetadataFile);
+		return TSharedPtr<FMonoAssemblyMetadata>();
+	}
+
+	TSharedPtr<FMonoAssemblyMetadata> Metadata(new FMonoAssemblyMetadata());
+
+	FString ErrorMessage;
+	FMonoMetadataBinaryReader Reader(BinaryData);
+	if (!Reader.ReadHeader(ErrorMessage) || !Metadata->ParseFromBinary(ErrorMessage, Reader))
+	{
+		UE_LOG(LogMono, Warning, TEXT("Error parsing binary assembly metadata '%s': '%s', falling back to json"), *BinaryMetadataFile, *ErrorMessage);
+		return TSharedPtr<FMonoAssemblyMetadata>();
+	}
+	if (!Reader.IsAtEnd())
+	{
+		UE_LOG(LogMono, Warning, TEXT("Binary assembly metadata '%s' has unexpected trailing data, falling back to json"), *BinaryMetadataFile);
+		return TSharedPtr<FMonoAssemblyMetadata>();
+	}
+
+	// the guid has to be hashed from the json text exactly as the json loader does, which is cheap next to parsing it
+	FString MetadataJsonString;
+	if (!FFileHelper::LoadFileToString(MetadataJsonString, *MetadataFile))
+	{
+		UE_LOG(LogMono, Warning, TEXT("Could not load '%s' to hash the script package guid for binary assembly metadata '%s'"), *MetadataFile, *BinaryMetadataFile);
+		return TSharedPtr<FMonoAssemblyMetadata>();
+	}
+	ScriptPackageGuid = HashMetadataJson(MetadataJsonString);
 
 	return Metadata;
 }
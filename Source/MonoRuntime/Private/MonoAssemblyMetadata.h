@@ -12,6 +12,7 @@
 #include <mono/metadata/object.h>
 
 class FJsonObject;
+class FMonoMetadataBinaryReader;
 class FMonoBindings;
 
 enum class EMonoAccessModifier : uint8
@@ -27,6 +28,7 @@ struct FMonoKeyValuePair
 	FString Value;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 
 };
 
@@ -37,6 +39,7 @@ struct MONORUNTIME_API FMonoTypeReferenceMetadata
 	FString AssemblyName;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 
 	FString GetQualifiedName() const;
 
@@ -55,9 +58,11 @@ struct FMonoUnrealType
 	virtual ~FMonoUnrealType();
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 
 
 	static bool ParseDerivedFromJsonObject(TUniquePtr<FMonoUnrealType>& Dest, FString& ErrorMessage, const FJsonObject& Object);
+	static bool ParseDerivedFromBinary(TUniquePtr<FMonoUnrealType>& Dest, FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 };
 
 struct FMonoCoreStructType : public FMonoUnrealType
@@ -65,6 +70,7 @@ struct FMonoCoreStructType : public FMonoUnrealType
 	FString StructName;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoStructType : public FMonoUnrealType
@@ -73,6 +79,7 @@ struct FMonoStructType : public FMonoUnrealType
 	FMonoTypeReferenceMetadata TypeRef;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoUnrealEnumType : public FMonoUnrealType
@@ -82,6 +89,7 @@ struct FMonoUnrealEnumType : public FMonoUnrealType
 	FMonoTypeReferenceMetadata TypeRef;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoUnrealObjectType : public FMonoUnrealType
@@ -89,6 +97,7 @@ struct FMonoUnrealObjectType : public FMonoUnrealType
 	FMonoTypeReferenceMetadata TypeRef;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoUnrealClassType : public FMonoUnrealType
@@ -96,6 +105,7 @@ struct FMonoUnrealClassType : public FMonoUnrealType
 	FMonoTypeReferenceMetadata TypeRef;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoUnrealWeakObjectType : public FMonoUnrealType
@@ -103,6 +113,7 @@ struct FMonoUnrealWeakObjectType : public FMonoUnrealType
 	FMonoTypeReferenceMetadata TypeRef;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
 struct FMonoMetadataBase
@@ -118,6 +129,9 @@ protected:
 
 public:
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
+
+	EMonoAccessModifier GetProtection() const { return Protection; }
 
 	virtual ~FMonoMetadataBase() {}
 };
@@ -128,6 +142,7 @@ struct FMonoPropertyMetadata : public FMonoMetadataBase
 
 	EPropertyFlags GetPropertyFlags() const;
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 
 private:
 	EPropertyFlags PropertyFlags;
@@ -141,6 +156,7 @@ struct FMonoFunctionMetadata : public FMonoMetadataBase
 
 	EFunctionFlags GetFunctionFlags() const;
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 
 private:
 	EFunctionFlags FunctionFlags;
@@ -154,6 +170,7 @@ struct FMonoEnumMetadata : public FMonoTypeReferenceMetadata
 	bool BlueprintVisible;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 private:
 };
 
@@ -179,6 +196,7 @@ struct FMonoClassMetadata : public FMonoTypeReferenceMetadata
 	uint64 ClassFlags;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 
 	TArray<FName> GetVirtualFunctions() const;
 
@@ -191,6 +209,7 @@ struct FMonoStructMetadata : public FMonoTypeReferenceMetadata
 	FString StructHash;
 	
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 };
 
 struct FMonoAssemblyReferenceMetadata
@@ -201,6 +220,7 @@ struct FMonoAssemblyReferenceMetadata
 	bool	InKnownLocation;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 };
 
 struct FMonoAssemblyMetadata
@@ -213,6 +233,7 @@ struct FMonoAssemblyMetadata
 	TArray<FMonoEnumMetadata> Enums;
 
 	bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object);
+	bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader);
 };
 
 struct FMonoLoadedAssemblyMetadata
@@ -225,7 +246,15 @@ struct FMonoLoadedAssemblyMetadata
 	static bool LoadAssemblyMetadataInDirectory(TArray<FMonoLoadedAssemblyMetadata>& Loaded, const FString& InDirectory);
 
 private:
-	static TSharedPtr<FMonoAssemblyMetadata> LoadAssemblyMetadata(FGuid& ScriptPackageGuid, const FString& InMetadataFile);
+	friend class FMonoRuntimeAssemblyMetadataLoaderTests;
+
+	// These run on task graph threads, so errors are returned for the caller to report rather than sent to the message log.
+	static TSharedPtr<FMonoAssemblyMetadata> LoadAssemblyMetadata(FGuid& ScriptPackageGuid, TArray<FText>& OutErrors, const FString& InMetadataFile);
+	static TSharedPtr<FMonoAssemblyMetadata> LoadJsonAssemblyMetadata(FGuid& ScriptPackageGuid, TArray<FText>& OutErrors, const FString& InMetadataFile);
+	// Loads the binary .metadata written next to the json, if there is an up to date one. Returns null to fall back to the json.
+	static TSharedPtr<FMonoAssemblyMetadata> LoadBinaryAssemblyMetadata(FGuid& ScriptPackageGuid, const FString& InMetadataFile);
+	// Script package guid for a json file's contents, the binary loader hashes the json next to it so both loaders agree.
+	static FGuid HashMetadataJson(const FString& MetadataJsonString);
 
 };
 
@@ -234,5 +263,6 @@ struct FMonoUnrealArrayType : public FMonoUnrealType
 	FMonoPropertyMetadata InnerProperty;
 
 	virtual bool ParseFromJsonObject(FString& ErrorMessage, const FJsonObject& Object) override;
+	virtual bool ParseFromBinary(FString& ErrorMessage, FMonoMetadataBinaryReader& Reader) override;
 };
 
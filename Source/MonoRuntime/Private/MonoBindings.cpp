@@ -10,27 +10,33 @@
 #include "MonoUnrealClass.h"
 #include "MonoMainDomain.h"
 #include "MonoPropertyFactory.h"
+#include "MonoWrapperPool.h"
 
 #include "Logging/MessageLog.h"
-#include "Interfaces/IPluginManager.h"
 #include "UObject/UObjectIterator.h"
+#include "UObject/GarbageCollection.h"
 #include "UObject/Package.h"
 #include "GameFramework/Actor.h"
 #include "Misc/FeedbackContext.h"
 #include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 
 #if WITH_EDITOR
 #include "DesktopPlatformModule.h"
 #endif // WITH_EDITOR
 
+#include <mono/metadata/reflection.h>
+
 #include "MonoBindingsDerived.inl"
 #include "../../MonoScriptGenerator/Private/MapModuleName.inl"
 
 #define LOCTEXT_NAMESPACE "MonoRuntime"
 
+DECLARE_CYCLE_STAT(TEXT("Load Script Package Bindings"), STAT_MonoLoadScriptPackageBindings, STATGROUP_Mono);
+
 struct FObjectInitializerWrapper
 {
 	const UObject* NativeObject;
@@ -42,19 +48,6 @@ static FString GetBuiltinModuleBindingsAssemblyName()
 	return FString(MONO_UE4_NAMESPACE ".BuiltinModules");
 }
 
-static void GatherAlreadyLoadedScriptPackages(TSet<FName>& AlreadyLoadedScriptPackages)
-{
-	// we only want actual UClasses, not any blueprint ones
-	for (TObjectIterator<UClass> ClassIt(RF_ClassDefaultObject, false); ClassIt; ++ClassIt)
-	{
-		UClass* Class = *ClassIt;
-		UPackage* Package = Class->GetTypedOuter<UPackage>();
-		check(Package);
-
-		AlreadyLoadedScriptPackages.Add(Package->GetFName());
-	}
-}
-
 namespace Mono
 {
 	// TODO: could make an easier way to marshal structs, but this'll do for now
@@ -80,12 +73,12 @@ extern void AddUnrealObjectInternalCalls();
 FMonoBindings::CachedUnrealClass::CachedUnrealClass()
 	: Class(nullptr)
 	, WrapperClass(nullptr)
-	, NativeWrapperConstructor(nullptr)
+	, NativeObjectField(nullptr)
 {
 
 }
 
-bool FMonoBindings::CachedUnrealClass::Resolve(const FCachedAssembly& CachedAssembly, MonoClass* ManagedClass, MonoClass* ManagedWrapperClass, UClass& UnrealClass)
+bool FMonoBindings::CachedUnrealClass::Resolve(const FCachedAssembly& CachedAssembly, MonoClass* ManagedClass, MonoClass* ManagedWrapperClass, UClass& UnrealClass, MonoClass* TrivialWrapperAttributeClass, MonoClassField* UnrealObjectNativeObjectField)
 {
 	const FString ClassName = UnrealClass.GetName();
 
@@ -106,8 +99,8 @@ bool FMonoBindings::CachedUnrealClass::Resolve(const FCachedAssembly& CachedAsse
 		WrapperClass = Class;
 	}
 
-	NativeWrapperConstructor = Mono::LookupMethodOnClass(WrapperClass, ":.ctor(intptr)");
-	if (nullptr == NativeWrapperConstructor)
+	MonoMethod* NativeWrapperConstructorMethod = Mono::LookupMethodOnClass(WrapperClass, ":.ctor(intptr)");
+	if (nullptr == NativeWrapperConstructorMethod)
 	{
 		FFormatNamedArguments Args;
 		Args.Add(TEXT("ManagedClassName"), FText::FromString(FString::Printf(TEXT("%s.%s"), ANSI_TO_TCHAR(mono_class_get_namespace(WrapperClass)), ANSI_TO_TCHAR(mono_class_get_name(WrapperClass)))));
@@ -115,6 +108,20 @@ bool FMonoBindings::CachedUnrealClass::Resolve(const FCachedAssembly& CachedAsse
 		FMessageLog(NAME_MonoErrors).Warning(FText::Format(LOCTEXT("CouldNotFindWrapperClassConstructor", "Found managed wrapper class 'ManagedClassName' for unreal class '{ClassName}', but it did not have a constructor of the form '{ClassName}(IntPtr)'"), Args));
 		return false;
 	}
+	NativeWrapperConstructor = TMonoThunk<void(MonoObject*, UObject*)>(NativeWrapperConstructorMethod);
+
+	check(TrivialWrapperAttributeClass);
+	check(UnrealObjectNativeObjectField);
+	MonoCustomAttrInfo* WrapperClassAttributes = mono_custom_attrs_from_class(WrapperClass);
+	if (nullptr != WrapperClassAttributes)
+	{
+		if (mono_custom_attrs_has_attr(WrapperClassAttributes, TrivialWrapperAttributeClass))
+		{
+			NativeObjectField = UnrealObjectNativeObjectField;
+		}
+		mono_custom_attrs_free(WrapperClassAttributes);
+	}
+
 	return true;
 
 }
@@ -122,8 +129,25 @@ bool FMonoBindings::CachedUnrealClass::Resolve(const FCachedAssembly& CachedAsse
 MonoObject* FMonoBindings::CachedUnrealClass::ConstructUnrealObjectWrapper(const FMonoBindings& InBindings, UObject& InObject) const
 {
 	check(WrapperClass);
-	check(NativeWrapperConstructor);
-	return Mono::ConstructObject(InBindings, WrapperClass, NativeWrapperConstructor, (PTRINT)&InObject);
+	check(NativeWrapperConstructor.IsBound());
+
+	MonoObject* PooledWrapper = FMonoWrapperPool::Get().Acquire(WrapperClass, InObject);
+	if (nullptr != PooledWrapper)
+	{
+		return PooledWrapper;
+	}
+
+	if (nullptr != NativeObjectField)
+	{
+		MonoObject* Wrapper = mono_object_new(InBindings.GetDomain(), WrapperClass);
+		UObject* NativeObject = &InObject;
+		mono_field_set_value(Wrapper, NativeObjectField, &NativeObject);
+		return Wrapper;
+	}
+
+	MonoObject* Wrapper = mono_object_new(InBindings.GetDomain(), WrapperClass);
+	NativeWrapperConstructor.Invoke(InBindings, Wrapper, &InObject);
+	return Wrapper;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -221,6 +245,8 @@ FMonoBindings::MonoRuntimeState::MonoRuntimeState()
 	: BindingsGCHandle(0)
 	, NameClass(nullptr)
 	, LifetimeReplicatedPropertyClass(nullptr)
+	, TrivialWrapperAttributeClass(nullptr)
+	, UnrealObjectNativeObjectField(nullptr)
 	, LoadAssemblyMethod(nullptr)
 	, FindUnrealClassesInAssemblyMethod(nullptr)
 	, GetLifetimeReplicationListMethod(nullptr)
@@ -234,6 +260,8 @@ FMonoBindings::MonoRuntimeState::MonoRuntimeState(MonoRuntimeState&& Other)
 	: BindingsGCHandle(0)
 	, NameClass(nullptr)
 	, LifetimeReplicatedPropertyClass(nullptr)
+	, TrivialWrapperAttributeClass(nullptr)
+	, UnrealObjectNativeObjectField(nullptr)
 	, LoadAssemblyMethod(nullptr)
 	, FindUnrealClassesInAssemblyMethod(nullptr)
 	, GetLifetimeReplicationListMethod(nullptr)
@@ -270,6 +298,10 @@ FMonoBindings::MonoRuntimeState& FMonoBindings::MonoRuntimeState::operator=(Mono
 		Other.NameClass = nullptr;
 		LifetimeReplicatedPropertyClass = Other.LifetimeReplicatedPropertyClass;
 		Other.LifetimeReplicatedPropertyClass = nullptr;
+		TrivialWrapperAttributeClass = Other.TrivialWrapperAttributeClass;
+		Other.TrivialWrapperAttributeClass = nullptr;
+		UnrealObjectNativeObjectField = Other.UnrealObjectNativeObjectField;
+		Other.UnrealObjectNativeObjectField = nullptr;
 		LoadAssemblyMethod = Other.LoadAssemblyMethod;
 		Other.LoadAssemblyMethod = nullptr;
 		FindUnrealClassesInAssemblyMethod = Other.FindUnrealClassesInAssemblyMethod;
@@ -442,6 +474,7 @@ FMonoBindings::FMonoBindings(FMonoMainDomain& InMainDomain, const FString& InEng
 	, MainDomain(InMainDomain)
 	, EngineAssemblyDirectory(InEngineAssemblyDirectory)
 	, GameAssemblyDirectory(InGameAssemblyDirectory)
+	, BindingsAssemblyResolver(InEngineAssemblyDirectory, InGameAssemblyDirectory)
 #if MONO_WITH_HOT_RELOADING
 	, CurrentReloadContext(nullptr)
 	, HotReloadCommand(TEXT("MonoRuntime.HotReload"),
@@ -469,6 +502,8 @@ FMonoBindings::FMonoBindings(FMonoMainDomain& InMainDomain, const FString& InEng
 
 FMonoBindings::~FMonoBindings()
 {
+	FMonoWrapperPool::Get().Empty();
+
 	check(this == GInstance);
 	GInstance = nullptr;
 }
@@ -617,7 +652,10 @@ void FMonoBindings::HACK_SetOldDomainAsCurrent()
 	check(CurrentReloadContext != nullptr);
 	if (CurrentReloadContext->HACK_DomainInMonoBindings != HACK_CurrentActiveDomain::OldDomain)
 	{
-		Exchange(CurrentReloadContext->CachedRuntimeState, RuntimeState);
+		{
+			FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+			Exchange(CurrentReloadContext->CachedRuntimeState, RuntimeState);
+		}
 		MonoDomain* OldDomain = CurrentReloadContext->CachedPreviousDomain;
 		CurrentReloadContext->CachedPreviousDomain = GetDomain();
 		SetDomain(OldDomain);
@@ -631,7 +669,10 @@ void FMonoBindings::HACK_SetNewDomainAsCurrent()
 	check(CurrentReloadContext != nullptr);
 	if (CurrentReloadContext->HACK_DomainInMonoBindings != HACK_CurrentActiveDomain::NewDomain)
 	{
-		Exchange(CurrentReloadContext->CachedRuntimeState, RuntimeState);
+		{
+			FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+			Exchange(CurrentReloadContext->CachedRuntimeState, RuntimeState);
+		}
 		MonoDomain* OldDomain = CurrentReloadContext->CachedPreviousDomain;
 		CurrentReloadContext->CachedPreviousDomain = GetDomain();
 		SetDomain(OldDomain);
@@ -644,9 +685,14 @@ void FMonoBindings::BeginReload(ReloadContext& Context, bool bReinstancing)
 {
 	check(IsInGameThread());
 	RuntimeState.MonoObjectTable.ResetForReload();
+	// pooled wrappers belong to the old domain
+	FMonoWrapperPool::Get().Empty();
 
 	// cache off runtime state
-	Context.CachedRuntimeState = MoveTemp(RuntimeState);
+	{
+		FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+		Context.CachedRuntimeState = MoveTemp(RuntimeState);
+	}
 
 	// Track managed objects so we can recreate their companions
 	Context.CachedRuntimeState.MonoObjectTable.GetObjectsWithCompanions(Context.ManagedObjects);
@@ -748,7 +794,10 @@ void FMonoBindings::EndReload(ReloadContext& Context)
 			// But that doesn't seem worth the complexity
 			UE_LOG(LogMono, Log, TEXT("Class %s was deleted during hot reload."), *MonoUnrealClass->GetPathName());
 			MonoUnrealClass->SetDeletedDuringHotReload(true);
-			RuntimeState.MonoClasses.Add(MonoUnrealClass);
+			{
+				FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+				RuntimeState.MonoClasses.Add(MonoUnrealClass);
+			}
 			DeletedClasses.Add(MonoUnrealClass);
 		}
 
@@ -803,7 +852,10 @@ void FMonoBindings::CancelReload(ReloadContext& Context)
 	check(Context.HACK_DomainInMonoBindings == HACK_CurrentActiveDomain::NewDomain);
 
 	// TODO: unload newly created domain here
-	RuntimeState = MoveTemp(Context.CachedRuntimeState);
+	{
+		FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+		RuntimeState = MoveTemp(Context.CachedRuntimeState);
+	}
 	SetDomain(Context.CachedPreviousDomain);
 
 	for (auto&& PreviousStruct : Context.ReloadStructs)
@@ -1060,6 +1112,9 @@ bool FMonoBindings::InitializeDomain(const TArray<FMonoLoadedAssemblyMetadata>&
 	RuntimeState.LifetimeReplicatedPropertyClass = RuntimeState.MonoBindingsAssembly->GetClass(MONO_BINDINGS_NAMESPACE, "LifetimeReplicatedProperty");
 	check(RuntimeState.LifetimeReplicatedPropertyClass);
 
+	RuntimeState.TrivialWrapperAttributeClass = RuntimeState.MonoBindingsAssembly->GetClass(MONO_BINDINGS_NAMESPACE, "TrivialWrapperAttribute");
+	check(RuntimeState.TrivialWrapperAttributeClass);
+
 	RuntimeState.LoadAssemblyMethod = RuntimeState.MonoBindingsAssembly->LookupMethod(MONO_BINDINGS_NAMESPACE ".Bindings:LoadAssembly");
 	check(RuntimeState.LoadAssemblyMethod);
 
@@ -1072,10 +1127,16 @@ bool FMonoBindings::InitializeDomain(const TArray<FMonoLoadedAssemblyMetadata>&
 	RuntimeState.GetCustomReplicationListMethod = RuntimeState.MonoBindingsAssembly->LookupMethod(MONO_BINDINGS_NAMESPACE ".UnrealObject:GetCustomReplicationList");
 	check(RuntimeState.GetCustomReplicationListMethod);
 
-	MonoMethod* ClearNativePointerMethod = RuntimeState.MonoBindingsAssembly->LookupMethod(MONO_BINDINGS_NAMESPACE ".UnrealObject:ClearNativePointer");
-	check(ClearNativePointerMethod);
+	MonoMethod* ClearNativePointersMethod = RuntimeState.MonoBindingsAssembly->LookupMethod(MONO_BINDINGS_NAMESPACE ".UnrealObject:ClearNativePointers");
+	check(ClearNativePointersMethod);
 
-	RuntimeState.MonoObjectTable.Initialize(*this, ClearNativePointerMethod);
+	RuntimeState.MonoObjectTable.Initialize(*this, ClearNativePointersMethod);
+
+	RuntimeState.UnrealObjectNativeObjectField = mono_class_get_field_from_name(UnrealObjectClass, "_NativeObject");
+	check(RuntimeState.UnrealObjectNativeObjectField);
+	MonoClass* PooledWrapperAttributeClass = RuntimeState.MonoBindingsAssembly->GetClass(MONO_BINDINGS_NAMESPACE, "PooledWrapperAttribute");
+	check(PooledWrapperAttributeClass);
+	FMonoWrapperPool::Get().Initialize(GetDomain(), RuntimeState.UnrealObjectNativeObjectField, PooledWrapperAttributeClass);
 
 	// Call our one time setup C# side
 	MonoMethod* InitializeMethod = RuntimeState.MonoBindingsAssembly->LookupMethod(MONO_BINDINGS_NAMESPACE ".Bindings:Initialize");
@@ -1103,7 +1164,10 @@ bool FMonoBindings::InitializeDomain(const TArray<FMonoLoadedAssemblyMetadata>&
 
 	// TODO: handle on the fly modules
 	TSet<FName> AlreadyLoadedScriptPackages;
-	GatherAlreadyLoadedScriptPackages(AlreadyLoadedScriptPackages);
+	ScriptPackageClassIndex.GetPackageNames(AlreadyLoadedScriptPackages);
+
+	// assemblies may have been built since the last domain load
+	BindingsAssemblyResolver.Refresh();
 
 	LoadBindingsForScriptPackages(AlreadyLoadedScriptPackages);
 
@@ -1136,13 +1200,16 @@ void FMonoBindings::ThrowUnrealObjectDestroyedException(const FString& Message)
 
 MonoObject* FMonoBindings::GetUnrealObjectWrapper(UObject* InObject) const
 {
-	checkSlow(IsInGameThread());
-
 	if (nullptr == InObject)
 	{
 		return nullptr;
 	}
 
+	if (!IsInGameThread())
+	{
+		return GetUnrealObjectWrapperConcurrent(*InObject);
+	}
+
 	if (InObject->IsPendingKill())
 	{
 		// if we're pending kill, return null
@@ -1156,13 +1223,57 @@ MonoObject* FMonoBindings::GetUnrealObjectWrapper(UObject* InObject) const
 	if (nullptr == WrapperObject)
 	{
 		WrapperObject = ConstructUnrealObjectWrapper(*InObject);
-		RuntimeState.MonoObjectTable.AddWrapperObject(*InObject, WrapperObject);
+		WrapperObject = RuntimeState.MonoObjectTable.AddWrapperObject(*InObject, WrapperObject);
 	}
 
 	check(WrapperObject)
 	return WrapperObject;
 }
 
+MonoObject* FMonoBindings::GetUnrealObjectWrapperConcurrent(UObject& InObject) const
+{
+	// Hold off unreal's GC until the wrapper is published, so the publication is adopted before the GC traces the object table
+	// and the object's index can't be reused before then. The caller is responsible for keeping the object alive afterwards,
+	// same as any other UObject access.
+	FGCScopeGuard GCGuard;
+
+	// Pending kill objects are left in the table for the game thread to remove.
+	if (InObject.IsPendingKill() || InObject.IsUnreachable())
+	{
+		return nullptr;
+	}
+
+	// copied, so the wrapper can be constructed without holding the lock
+	CachedUnrealClass WrapperClass;
+	{
+		FReadScopeLock RuntimeStateReadLock(RuntimeStateLock);
+
+		MonoObject* WrapperObject = RuntimeState.MonoObjectTable.GetManagedObjectConcurrent(InObject);
+		if (nullptr != WrapperObject)
+		{
+			return WrapperObject;
+		}
+
+		const CachedUnrealClass& FoundClass = FindCachedUnrealClass(*InObject.GetClass());
+		FoundClass.CompileWrapperConstructor();
+		WrapperClass = FoundClass;
+	}
+
+	// constructing the wrapper may run managed code, which can call back into anything that takes the lock for writing
+	MonoObject* WrapperObject = WrapperClass.ConstructUnrealObjectWrapper(*this, InObject);
+
+	{
+		// publishing doesn't run managed code, the lock only keeps the game thread from swapping the table out from under us
+		FReadScopeLock RuntimeStateReadLock(RuntimeStateLock);
+
+		// if another thread publishes a wrapper first, we get theirs back and ours is left for the managed GC
+		WrapperObject = RuntimeState.MonoObjectTable.AddWrapperObject(InObject, WrapperObject);
+	}
+
+	check(WrapperObject);
+	return WrapperObject;
+}
+
 bool FMonoBindings::InitializeMonoClasses()
 {
 	bool bAnyFailed = false;
@@ -1387,8 +1498,12 @@ MonoType* FMonoBindings::ResolveTypeReference(const FMonoTypeReferenceMetadata&
 
 MonoObject* FMonoBindings::ConstructUnrealObjectWrapper(UObject& InObject) const
 {
-	UClass* Class = InObject.GetClass();
-	check(Class);
+	return FindCachedUnrealClass(*InObject.GetClass()).ConstructUnrealObjectWrapper(*this, InObject);
+}
+
+const FMonoBindings::CachedUnrealClass& FMonoBindings::FindCachedUnrealClass(UClass& InClass) const
+{
+	UClass* Class = &InClass;
 	check(!Class->HasAnyClassFlags(CLASS_Abstract)); // shouldn't ever get an abstract class here (how'd we get an instance?)
 
 	// look up our mono wrapper
@@ -1402,11 +1517,13 @@ MonoObject* FMonoBindings::ConstructUnrealObjectWrapper(UObject& InObject) const
 		check(Class);
 	}
 	check(CachedClass);
-	return CachedClass->ConstructUnrealObjectWrapper(*this, InObject);
+	return *CachedClass;
 }
 
 void FMonoBindings::LoadBindingsForScriptPackages(const TSet<FName>& ScriptPackages)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MonoLoadScriptPackageBindings);
+
 	TMap<FName, FString> UnloadedScriptPackageBindings = GetUnloadedScriptPackageBindings(ScriptPackages);
 
 	for (const auto& Module : UnloadedScriptPackageBindings)
@@ -1450,21 +1567,6 @@ TSharedPtr<FCachedAssembly> FMonoBindings::LoadAssembly(FString& ErrorString, co
 	return CachedAssembly;
 }
 
-bool IsPluginModule(const FName ModuleName)
-{
-	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
-	{
-		for (const FModuleDescriptor ModuleInfo : Plugin->GetDescriptor().Modules)
-		{
-			if (ModuleInfo.Name == ModuleName)
-			{
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
 TMap<FName, FString> FMonoBindings::GetUnloadedScriptPackageBindings(const TSet<FName>& ScriptPackageSet) const
 {
 	TMap<FName, FString> BoundScriptPackages;
@@ -1479,7 +1581,7 @@ TMap<FName, FString> FMonoBindings::GetUnloadedScriptPackageBindings(const TSet<
 		{
 			FName ModuleName = FPackageName::GetShortFName(ScriptPackageName);
 
-			bool bIsPlugin = IsPluginModule(ModuleName);
+			bool bIsPlugin = BindingsAssemblyResolver.IsPluginModule(ModuleName);
 			bool bGameModuleStatusDetermined = true;
 
 			FString AssemblyName;
@@ -1510,38 +1612,18 @@ TMap<FName, FString> FMonoBindings::GetUnloadedScriptPackageBindings(const TSet<
 			}
 
 
-			FString BindingsAssemblyDLL = AssemblyName + TEXT(".dll");
-
-			FString PotentialPaths[4];
-
-			// support bindings assemblies living in either engine (engine modules and plugins) or game (game modules and plugins).
-			PotentialPaths[0] = FPaths::Combine(*EngineAssemblyDirectory, *BindingsAssemblyDLL);
-			PotentialPaths[1] = FPaths::Combine(*GameAssemblyDirectory, *BindingsAssemblyDLL);
-			if (!bGameModuleStatusDetermined)
+			FString BindingsAssemblyPath = BindingsAssemblyResolver.FindBindingsAssembly(AssemblyName);
+			if (BindingsAssemblyPath.IsEmpty() && !bGameModuleStatusDetermined)
 			{
 				// if it might be a game module, we try the game module resolution first
 				// Otherwise it must be a builtin
 				check(!bIsPlugin);
-				AssemblyName = GetBuiltinModuleBindingsAssemblyName();
-				BindingsAssemblyDLL = AssemblyName + TEXT(".dll");
-				PotentialPaths[2] = FPaths::Combine(*EngineAssemblyDirectory, *BindingsAssemblyDLL);
-				PotentialPaths[3] = FPaths::Combine(*GameAssemblyDirectory, *BindingsAssemblyDLL);
+				BindingsAssemblyPath = BindingsAssemblyResolver.FindBindingsAssembly(GetBuiltinModuleBindingsAssemblyName());
 			}
 
-			for (int i = 0; i < ARRAY_COUNT(PotentialPaths); ++i)
+			if (!BindingsAssemblyPath.IsEmpty())
 			{
-				if (PotentialPaths[i].IsEmpty())
-				{
-					continue;
-				}
-
-				// ignore assemblies with side-by-side json files, those aren't bindings assemblies
-				const FString PotentialMetadataFile = FPaths::GetBaseFilename(PotentialPaths[i], false) + TEXT(".json");
-				if (FPaths::FileExists(PotentialPaths[i]) && !FPaths::FileExists(PotentialMetadataFile))
-				{
-					BoundScriptPackages.Add(ScriptPackageName, PotentialPaths[i]);
-					break;
-				}
+				BoundScriptPackages.Add(ScriptPackageName, BindingsAssemblyPath);
 			}
 		}
 	}
@@ -1579,21 +1661,8 @@ namespace Mono
 void FMonoBindings::CacheUnrealClassesForAssembly(FName ScriptPackageName, const FCachedAssembly& CachedAssembly)
 {
 	FString ModuleName = ScriptGenUtil::MapModuleNameToScriptModuleName (FPackageName::GetShortFName(ScriptPackageName)).ToString();
-	TSet<UClass*> UnrealClassesInPackage;
-
-	// we only want actual UClasses, not any blueprint ones
-	for (TObjectIterator<UClass> ClassIt(RF_ClassDefaultObject, false); ClassIt; ++ClassIt)
-	{
-		UClass* Class = *ClassIt;
-		UPackage* Package = Class->GetTypedOuter<UPackage>();
-		check(Package);
-
-
-		if (Package->GetFName() == ScriptPackageName)
-		{
-			UnrealClassesInPackage.Add(Class);
-		}
-	}
+	TArray<UClass*> UnrealClassesInPackage;
+	ScriptPackageClassIndex.GetClassesInPackage(ScriptPackageName, UnrealClassesInPackage);
 
 	TMap<UClass*, CachedUnrealClass> CachedClasses;
 
@@ -1635,7 +1704,7 @@ void FMonoBindings::CacheUnrealClassesForAssembly(FName ScriptPackageName, const
 
 			CachedUnrealClass CachedClass;
 			
-			if (CachedClass.Resolve(CachedAssembly, ManagedClass, ManagedWrapperClass, *UnrealClass))
+			if (CachedClass.Resolve(CachedAssembly, ManagedClass, ManagedWrapperClass, *UnrealClass, RuntimeState.TrivialWrapperAttributeClass, RuntimeState.UnrealObjectNativeObjectField))
 			{
 				CachedClasses.Add(UnrealClass, CachedClass);
 			}
@@ -1659,7 +1728,11 @@ void FMonoBindings::CacheUnrealClassesForAssembly(FName ScriptPackageName, const
 			// For now I create a mapping from the wrapper class to the unreal class
 			RuntimeState.MonoTypeToUnrealTypeMap.Add(mono_class_get_type(CachedClass.GetWrapperClass()), UnrealTypeReference(*Class));
 		}
-		RuntimeState.NativeWrapperMap.Add(Class, CachedClass);
+		{
+			FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+			RuntimeState.NativeWrapperMap.Add(Class, CachedClass);
+		}
+		FMonoWrapperPool::Get().RegisterWrapperClass(CachedClass.GetWrapperClass());
 	}
 }
 
@@ -2013,6 +2086,7 @@ bool FMonoBindings::CreateGameClass(DeferredUnrealClassCreationInfo& ClassInfo)
 
 			NewClass->HotReload(SuperClass, ClassInfo.NativeParentClass, MoveTemp(CompiledClassAsset), Metadata);
 
+			FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
 			RuntimeState.MonoClasses.Add(NewClass);
 		}
 	}
@@ -2035,7 +2109,10 @@ bool FMonoBindings::CreateGameClass(DeferredUnrealClassCreationInfo& ClassInfo)
 
 		ClassInfo.CreatedType = NewClass;
 
-		RuntimeState.MonoClasses.Add(NewClass);
+		{
+			FWriteScopeLock RuntimeStateWriteLock(RuntimeStateLock);
+			RuntimeState.MonoClasses.Add(NewClass);
+		}
 
 		// Now that NewClass is resolvable, it's safe to create UProperties and UFunctions,
 		// even if there are circular references.
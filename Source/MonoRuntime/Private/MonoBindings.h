@@ -16,6 +16,8 @@
 #include "MonoObjectTable.h"
 #include "MonoAssemblyMetadata.h"
 #include "MonoUnrealClass.h"
+#include "MonoScriptPackageClassIndex.h"
+#include "MonoBindingsAssemblyResolver.h"
 
 #include <mono/metadata/class.h>
 #include <mono/metadata/object.h>
@@ -67,6 +69,7 @@ public:
 
 	void ThrowUnrealObjectDestroyedException(const FString& Message);
 
+	// can be called from any thread. Off the game thread this goes through the object table's lock free path
 	MonoObject* GetUnrealObjectWrapper(UObject* InObject) const;
 
 	MonoClass* GetMonoClassFromUnrealClass(const UClass& InClass) const;
@@ -85,6 +88,9 @@ public:
 	
 	TSharedRef<FMonoDelegateHandle> CreateObjectDelegate(UObject& InOwner, MonoObject* Delegate, UObject* OptionalTargetObject);
 
+	const FString& GetEngineAssemblyDirectory() const { return EngineAssemblyDirectory; }
+	const FString& GetGameAssemblyDirectory() const { return GameAssemblyDirectory; }
+
 	const FCachedAssembly& GetBindingsAssembly() const { return *RuntimeState.MonoBindingsAssembly; }
 	const FCachedAssembly& GetRuntimeAssembly() const { return *RuntimeState.MonoRuntimeAssembly; }
 
@@ -104,20 +110,25 @@ private:
 	public:
 		CachedUnrealClass();
 
-		bool Resolve(const FCachedAssembly& CachedAssembly, MonoClass* ManagedClass, MonoClass* ManagedWrapperClass, UClass& UnrealClass);
+		bool Resolve(const FCachedAssembly& CachedAssembly, MonoClass* ManagedClass, MonoClass* ManagedWrapperClass, UClass& UnrealClass, MonoClass* TrivialWrapperAttributeClass, MonoClassField* UnrealObjectNativeObjectField);
 
 		MonoObject* ConstructUnrealObjectWrapper(const FMonoBindings& InBindings, UObject& InObject) const;
 
 		MonoClass* GetClass() const { return Class; }
 		MonoClass* GetWrapperClass() const { return WrapperClass; }
 
+		void CompileWrapperConstructor() const { NativeWrapperConstructor.Compile(); }
+
 	private:
 		MonoClass* Class; // class type corresponding to the unreal class, may be abstract
 		// Sometimes we need to create wrappers for abstract unreal classes. This can happen when we have the abstract base exposed in the bindings
 		// but the concrete derived class is unknown to our bindings. For these cases we create an object that is a concrete wrapper of the abstract base
 		// For non-abstract classes the wrapper class is the same as Class
 		MonoClass* WrapperClass; 
-		MonoMethod* NativeWrapperConstructor;
+		TMonoThunk<void(MonoObject*, UObject*)> NativeWrapperConstructor;
+		// set for wrapper classes marked [TrivialWrapper], whose constructor only stores the native pointer
+		// wrappers of those are created by writing the field directly instead of invoking the constructor
+		MonoClassField* NativeObjectField;
 	};
 
 	class DeferredUnrealTypeCreationInfo
@@ -263,6 +274,8 @@ private:
 
 		MonoClass*  NameClass;
 		MonoClass*	LifetimeReplicatedPropertyClass;
+		MonoClass*	TrivialWrapperAttributeClass;
+		MonoClassField* UnrealObjectNativeObjectField;
 		MonoMethod* LoadAssemblyMethod;
 		MonoMethod* FindUnrealClassesInAssemblyMethod;
 		MonoMethod* GetLifetimeReplicationListMethod;
@@ -379,6 +392,9 @@ private:
 	MonoType* ResolveTypeReference(const FMonoTypeReferenceMetadata& TypeReference) const;
 
 	MonoObject* ConstructUnrealObjectWrapper(UObject& InObject) const;
+	// the wrapper class for the nearest class with bindings, callers off the game thread must hold RuntimeStateLock for reading
+	const CachedUnrealClass& FindCachedUnrealClass(UClass& InClass) const;
+	MonoObject* GetUnrealObjectWrapperConcurrent(UObject& InObject) const;
 
 	void LoadBindingsForScriptPackages(const TSet<FName>& ScriptPackages);
 	TSharedPtr<FCachedAssembly> LoadAssembly(FString& ErrorString, const FString& AssemblyName);
@@ -399,6 +415,15 @@ private:
 	FString GameAssemblyDirectory;
 
 	MonoRuntimeState		RuntimeState;
+	// held for reading while another thread looks up a wrapper class or publishes a wrapper, never while managed code runs,
+	// and for writing while the game thread changes the class lookups or swaps the runtime state
+	mutable FRWLock			RuntimeStateLock;
+
+	// loaded classes by package, shared by everything that loads bindings for script packages
+	FMonoScriptPackageClassIndex ScriptPackageClassIndex;
+
+	// finds bindings assemblies for script packages without touching the file system per package
+	FMonoBindingsAssemblyResolver BindingsAssemblyResolver;
 
 #if MONO_WITH_HOT_RELOADING
 	ReloadContext*			 CurrentReloadContext;
@@ -37,7 +37,7 @@ ReturnValue FMonoDelegateHandle::Invoke()
 
 		if (nullptr != DelegateObject)
 		{
-			return Mono::InvokeDelegate<ReturnValue>(Bindings, DelegateObject);
+			return InvokeDelegateObject<ReturnValue>(DelegateObject);
 		}
 	}
 	return ReturnValue();
@@ -52,7 +52,7 @@ ReturnValue FMonoDelegateHandle::Invoke(Arg1Type argOne)
 
 		if (nullptr != DelegateObject)
 		{
-			return Mono::InvokeDelegate<ReturnValue>(Bindings, DelegateObject, argOne);
+			return InvokeDelegateObject<ReturnValue>(DelegateObject, argOne);
 		}
 	}
 	return ReturnValue();
@@ -67,12 +67,32 @@ ReturnValue FMonoDelegateHandle::Invoke(Arg1Type argOne, Arg2Type argTwo)
 
 		if (nullptr != DelegateObject)
 		{
-			return Mono::InvokeDelegate<ReturnValue>(Bindings, DelegateObject, argOne, argTwo);
+			return InvokeDelegateObject<ReturnValue>(DelegateObject, argOne, argTwo);
 		}
 	}
 	return ReturnValue();
 }
 
+template <class ReturnValue, typename... ArgTypes>
+typename TEnableIf<Mono::ThunkType<ReturnValue>::Value && Mono::AreThunkTypes<ArgTypes...>::Value, ReturnValue>::Type FMonoDelegateHandle::InvokeDelegateObject(MonoObject* DelegateObject, ArgTypes... Arguments)
+{
+	typedef TMonoThunk<ReturnValue(MonoObject*, ArgTypes...)> FDelegateThunk;
+	if (nullptr == DelegateThunk)
+	{
+		MonoMethod* DelegateInvokeMethod = mono_get_delegate_invoke(mono_object_get_class(DelegateObject));
+		check(DelegateInvokeMethod);
+		DelegateThunk = Mono::GetUnmanagedThunk(DelegateInvokeMethod);
+	}
+	bool bThrewException = false;
+	return FDelegateThunk::InvokeFunction(bThrewException, Bindings, (typename FDelegateThunk::FunctionPtr)DelegateThunk, DelegateObject, Arguments...);
+}
+
+template <class ReturnValue, typename... ArgTypes>
+typename TEnableIf<!(Mono::ThunkType<ReturnValue>::Value && Mono::AreThunkTypes<ArgTypes...>::Value), ReturnValue>::Type FMonoDelegateHandle::InvokeDelegateObject(MonoObject* DelegateObject, ArgTypes... Arguments)
+{
+	return Mono::InvokeDelegate<ReturnValue>(Bindings, DelegateObject, Arguments...);
+}
+
 #if MONO_WITH_HOT_RELOADING
 
 template<class T>
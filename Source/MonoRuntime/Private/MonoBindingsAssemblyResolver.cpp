@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#include "MonoBindingsAssemblyResolver.h"
+#include "MonoRuntimePrivate.h"
+#include "Interfaces/IPluginManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+FMonoBindingsAssemblyResolver::FMonoBindingsAssemblyResolver(const FString& InEngineAssemblyDirectory, const FString& InGameAssemblyDirectory)
+	: EngineAssemblyDirectory(InEngineAssemblyDirectory)
+	, GameAssemblyDirectory(InGameAssemblyDirectory)
+{
+}
+
+void FMonoBindingsAssemblyResolver::Refresh()
+{
+	PluginModules.Reset();
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		for (const FModuleDescriptor& ModuleInfo : Plugin->GetDescriptor().Modules)
+		{
+			PluginModules.Add(ModuleInfo.Name);
+		}
+	}
+
+	GatherFilesInDirectory(EngineAssemblyFiles, EngineAssemblyDirectory);
+	GatherFilesInDirectory(GameAssemblyFiles, GameAssemblyDirectory);
+}
+
+bool FMonoBindingsAssemblyResolver::IsPluginModule(FName ModuleName) const
+{
+	return PluginModules.Contains(ModuleName);
+}
+
+FString FMonoBindingsAssemblyResolver::FindBindingsAssembly(const FString& AssemblyName) const
+{
+	const FString AssemblyFile = AssemblyName + TEXT(".dll");
+	const FString MetadataFile = AssemblyName + TEXT(".json");
+
+	// support bindings assemblies living in either engine (engine modules and plugins) or game (game modules and plugins).
+	if (EngineAssemblyFiles.Contains(AssemblyFile) && !EngineAssemblyFiles.Contains(MetadataFile))
+	{
+		return FPaths::Combine(*EngineAssemblyDirectory, *AssemblyFile);
+	}
+
+	if (GameAssemblyFiles.Contains(AssemblyFile) && !GameAssemblyFiles.Contains(MetadataFile))
+	{
+		return FPaths::Combine(*GameAssemblyDirectory, *AssemblyFile);
+	}
+
+	return FString();
+}
+
+void FMonoBindingsAssemblyResolver::GatherFilesInDirectory(TSet<FString>& OutFiles, const FString& Directory)
+{
+	OutFiles.Reset();
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *FPaths::Combine(*Directory, TEXT("*")), true, false);
+	OutFiles.Append(Files);
+}
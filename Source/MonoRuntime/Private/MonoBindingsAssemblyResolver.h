@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Answers which bindings assembly serves a script package from memory.
+// Refresh collects the plugin module names and lists the engine and game assembly directories once, instead of
+// walking every plugin's modules and stat'ing several candidate paths (and their .json side-by-sides) per package.
+class FMonoBindingsAssemblyResolver
+{
+public:
+	FMonoBindingsAssemblyResolver(const FString& InEngineAssemblyDirectory, const FString& InGameAssemblyDirectory);
+
+	// Re-reads the plugin list and assembly directories; call before resolving a batch of packages
+	void Refresh();
+
+	bool IsPluginModule(FName ModuleName) const;
+
+	// Returns the path of AssemblyName.dll in the engine or game assembly directory, in that order, or an empty string.
+	// Assemblies with a side-by-side .json file are game assemblies, not bindings, and are ignored.
+	FString FindBindingsAssembly(const FString& AssemblyName) const;
+
+private:
+	static void GatherFilesInDirectory(TSet<FString>& OutFiles, const FString& Directory);
+
+	FString EngineAssemblyDirectory;
+	FString GameAssemblyDirectory;
+
+	TSet<FName> PluginModules;
+	// file names, compared case insensitively
+	TSet<FString> EngineAssemblyFiles;
+	TSet<FString> GameAssemblyFiles;
+};
@@ -9,6 +9,71 @@
 #include "MonoRuntimeCommon.h"
 #include "MonoBindings.h"
 #include "MonoHelpers.h"
+#include "UObject/UObjectArray.h"
+
+// Maps the object index of a managed UFunction to its call plan, so event dispatch is an indexed load instead of a map lookup.
+// UFunctions have no room for extra data and can't be subclassed with extra members, so the object index is the function id.
+// Only written on the game thread while classes are created, pages are published atomically for dispatch on other threads.
+class FMonoEventCallPlanTable
+{
+public:
+	typedef FMonoCompiledClassAsset::FMonoEventCallPlan FPlan;
+
+	~FMonoEventCallPlanTable()
+	{
+		for (TAtomic<const FPlan**>& PageRef : Pages)
+		{
+			delete[] PageRef.Exchange(nullptr);
+		}
+	}
+
+	const FPlan* Find(const UFunction& Function) const
+	{
+		const int32 Index = GUObjectArray.ObjectToIndex(&Function);
+		check(Index >= 0 && Index < SlotsPerPage * MaxPages);
+		const FPlan** Page = Pages[Index / SlotsPerPage].Load();
+		return nullptr != Page ? Page[Index % SlotsPerPage] : nullptr;
+	}
+
+	void Set(const UFunction& Function, const FPlan* Plan)
+	{
+		check(IsInGameThread());
+		const int32 Index = GUObjectArray.ObjectToIndex(&Function);
+		checkf(Index >= 0 && Index < SlotsPerPage * MaxPages, TEXT("Object index %d is out of range for the event call plan table"), Index);
+		TAtomic<const FPlan**>& PageRef = Pages[Index / SlotsPerPage];
+		const FPlan** Page = PageRef.Load();
+		if (nullptr == Page)
+		{
+			Page = new const FPlan*[SlotsPerPage];
+			FMemory::Memzero(Page, SlotsPerPage * sizeof(const FPlan*));
+			PageRef = Page;
+		}
+		Page[Index % SlotsPerPage] = Plan;
+	}
+
+	// clears the slot only if it still refers to Plan, a hot reloaded class may have replaced it already
+	void Remove(const UFunction& Function, const FPlan* Plan)
+	{
+		check(IsInGameThread());
+		const int32 Index = GUObjectArray.ObjectToIndex(&Function);
+		const FPlan** Page = Pages[Index / SlotsPerPage].Load();
+		if (nullptr != Page && Page[Index % SlotsPerPage] == Plan)
+		{
+			Page[Index % SlotsPerPage] = nullptr;
+		}
+	}
+
+private:
+	enum
+	{
+		SlotsPerPage = 4 * 1024,
+		MaxPages = 8 * 1024
+	};
+
+	TAtomic<const FPlan**> Pages[MaxPages];
+};
+
+static FMonoEventCallPlanTable GMonoEventCallPlans;
 
 TUniquePtr<FMonoCompiledClassAsset> FMonoCompiledClassAsset::CreateCompiledClassAsset(FString& ErrorString, 
 																					  FMonoBindings& InBindings, 
@@ -59,23 +124,65 @@ FMonoCompiledClassAsset::FMonoCompiledClassAsset(FMonoBindings& InBindings,
 	
 }
 
+FMonoCompiledClassAsset::~FMonoCompiledClassAsset()
+{
+	for (auto&& EventCallPlan : EventCallPlans)
+	{
+		GMonoEventCallPlans.Remove(*EventCallPlan.Key, EventCallPlan.Value.Get());
+	}
+}
+
 void FMonoCompiledClassAsset::CreateCompanionObject(UObject* NativeObject, const FObjectInitializer& ObjectInitializer) const
 {
 	Bindings.CreateCompanionObject(NativeObject, AssetClass, AssetConstructor, ObjectInitializer);
 }
 
+static bool NeedsCoTaskMemFree(const UProperty& Property)
+{
+	return Property.IsA(UStrProperty::StaticClass()) || Property.IsA(UArrayProperty::StaticClass());
+}
+
+FMonoCompiledClassAsset::FMonoEventCallPlan::FMonoEventCallPlan(UFunction& Function, MonoMethod* Method)
+	: Thunk(Method)
+	, ReturnProperty(nullptr)
+	, bReturnNeedsCoTaskMemFree(false)
+{
+	for (TFieldIterator<UProperty> ParamIt(&Function, EFieldIteratorFlags::ExcludeSuper); ParamIt; ++ParamIt)
+	{
+		UProperty* ParamProperty = *ParamIt;
+		ParamOffsets.Add(ParamProperty->GetOffset_ForUFunction());
+
+		// The return value is always flagged as an out parameter, but needs to be handled a little differently
+		if (ParamProperty->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			ReturnProperty = ParamProperty;
+			bReturnNeedsCoTaskMemFree = NeedsCoTaskMemFree(*ParamProperty);
+		}
+		else if (ParamProperty->HasAnyPropertyFlags(CPF_OutParm))
+		{
+			FOutParam& OutParam = OutParams[OutParams.AddUninitialized()];
+			OutParam.Property = ParamProperty;
+			OutParam.Offset = ParamProperty->GetOffset_ForUFunction();
+			OutParam.bNeedsCoTaskMemFree = NeedsCoTaskMemFree(*ParamProperty);
+		}
+	}
+}
+
 void FMonoCompiledClassAsset::InvokeMonoEvent(UObject* Object, FFrame& Stack, RESULT_DECL)
 {
 	UFunction* Func = Stack.CurrentNativeFunction;
+	const FMonoEventCallPlan* CallPlanPtr = GMonoEventCallPlans.Find(*Func);
+	checkf(CallPlanPtr, TEXT("No managed event call plan for function %s"), *Func->GetName());
+	const FMonoEventCallPlan& CallPlan = *CallPlanPtr;
+	check(CallPlan.Thunk.IsBound());
 
 	uint8* ParamBuffer = nullptr;
 	if (Stack.Code)
 	{
 		ParamBuffer = (uint8*)FMemory_Alloca(Func->ParmsSize);
-		for (TFieldIterator<UProperty> ParamIt(Func, EFieldIteratorFlags::ExcludeSuper); ParamIt; ++ParamIt)
+		for (int32 ParamOffset : CallPlan.ParamOffsets)
 		{
-			UProperty* Param = *ParamIt;
-			Stack.Step(Stack.Object, ParamBuffer + Param->GetOffset_ForUFunction());
+			Stack.Step(Stack.Object, ParamBuffer + ParamOffset);
 		}
 
 		P_FINISH;
@@ -84,82 +191,50 @@ void FMonoCompiledClassAsset::InvokeMonoEvent(UObject* Object, FFrame& Stack, RE
 	{
 		ParamBuffer = Stack.Locals;
 	}
-	
-	void* Arguments[] =
-	{ 
-		&ParamBuffer,
-		(void*)&RESULT_PARAM 
-	};
-
-	MonoMethod* EventMethod = MonoEventMap.FindChecked(Func);
-	check(EventMethod);
 
 	MonoObject* ObjectWrapper = Bindings.GetUnrealObjectWrapper(Object);
 	check(ObjectWrapper);
 
-	bool bThrewException = false;
-	Mono::Invoke(bThrewException, Bindings.GetExceptionBehavior(), Bindings.GetDomain(), EventMethod, ObjectWrapper, Arguments);
+	CallPlan.Thunk.Invoke(Bindings, ObjectWrapper, ParamBuffer, (void*)RESULT_PARAM);
 
 	// Copy out parameters from the stack back into the UFunction parameter buffer.
 	// Unfortunately, we can't just iterate over TheStack.OutParms because the list isn't NULL-terminated on non-debug builds.
-	// It may be worth submitting a pull request to address this if the nested loop to find each out parameter's FOutParmRec
-    // becomes a performance issue, but in practice, it should generally be a pretty short list.  The engine doesn't need it 
-    // NULL-terminated because it's only ever used to look up CPF_OutParm UProperties that are guaranteed to be found.
-	UProperty* ReturnProperty = NULL;
-	if (Func->HasAnyFunctionFlags(FUNC_HasOutParms))
+	// The records are in parameter order though, so the search for each one picks up where the previous one left off.
+	FOutParmRec* OutParmRec = Stack.OutParms;
+	for (const FMonoEventCallPlan::FOutParam& OutParam : CallPlan.OutParams)
 	{
-		for (TFieldIterator<UProperty> ParamIt(Func, EFieldIteratorFlags::ExcludeSuper); ParamIt; ++ParamIt)
+		check(OutParmRec);
+		while (OutParmRec->Property != OutParam.Property)
 		{
-			UProperty* ParamProperty = *ParamIt;
-
-			// The return value is always flagged as an out parameter, but needs to be handled a little differently,
-			// so just save it for later.
-			if (ParamProperty->HasAnyPropertyFlags(CPF_ReturnParm))
-			{
-				ReturnProperty = ParamProperty;
-			}
-			else if (ParamProperty->HasAnyPropertyFlags(CPF_OutParm))
-			{
-				FOutParmRec* OutParmRec = Stack.OutParms;
-				check(OutParmRec);
-				while (OutParmRec->Property != ParamProperty)
-				{
-					OutParmRec = OutParmRec->NextOutParm;
-				}
-
-				uint8* ParmMemory = reinterpret_cast<uint8*>(ParamBuffer)+ParamProperty->GetOffset_ForUFunction();
-				ParamProperty->InitializeValue(OutParmRec->PropAddr);
-				ParamProperty->CopyCompleteValue(OutParmRec->PropAddr, ParmMemory);
-
-				if (ParamProperty->IsA(UStrProperty::StaticClass()) || ParamProperty->IsA(UArrayProperty::StaticClass()))
-				{
-					FMarshalledScriptArray* RawArray = reinterpret_cast<FMarshalledScriptArray*>(ParmMemory);
-					
-					Mono::CoTaskMemFree(RawArray->Data);
-
-					RawArray->ArrayMax = RawArray->ArrayNum = 0;
-					RawArray->Data = nullptr;
-				}
-			}
+			OutParmRec = OutParmRec->NextOutParm;
 		}
-	}
-	else
-	{
-		// FUNC_HasOutParms doesn't apply if the return value is the function's only property with the CPF_OutParm flag,
-		// so we have to fetch it manually in that case.
-		ReturnProperty = Func->GetReturnProperty();
+
+		uint8* ParmMemory = ParamBuffer + OutParam.Offset;
+		OutParam.Property->InitializeValue(OutParmRec->PropAddr);
+		OutParam.Property->CopyCompleteValue(OutParmRec->PropAddr, ParmMemory);
+
+		if (OutParam.bNeedsCoTaskMemFree)
+		{
+			FMarshalledScriptArray* RawArray = reinterpret_cast<FMarshalledScriptArray*>(ParmMemory);
+
+			Mono::CoTaskMemFree(RawArray->Data);
+
+			RawArray->ArrayMax = RawArray->ArrayNum = 0;
+			RawArray->Data = nullptr;
+		}
+
+		OutParmRec = OutParmRec->NextOutParm;
 	}
 
 	// Result is already a pointer into the UFunction parameter buffer, so we don't need to copy anything in the general case,
 	// but we do need to shuffle some things around if there were any dynamic allocations involved in the marshaling.
-	if (ReturnProperty &&
-		(ReturnProperty->IsA(UStrProperty::StaticClass()) || ReturnProperty->IsA(UArrayProperty::StaticClass())))
+	if (CallPlan.bReturnNeedsCoTaskMemFree)
 	{
 		// Make a shallow copy of the marshaled array data, so we can clobber the original data with a proper Unreal type.
 		FMarshalledScriptArray RawArray(*reinterpret_cast<FMarshalledScriptArray*>(RESULT_PARAM));
 
-		ReturnProperty->InitializeValue(RESULT_PARAM);
-		ReturnProperty->CopyCompleteValue(RESULT_PARAM, &RawArray);
+		CallPlan.ReturnProperty->InitializeValue(RESULT_PARAM);
+		CallPlan.ReturnProperty->CopyCompleteValue(RESULT_PARAM, &RawArray);
 
 		Mono::CoTaskMemFree(RawArray.Data);
 	}
@@ -269,7 +344,9 @@ void FMonoCompiledClassAsset::AddFunctionsToEventMap(UMonoUnrealClass* Class, UC
 	MonoClass* SearchClass = AssetClass;
 	check(SearchClass);
 
-	for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	// Only functions our class created dispatch through InvokeMonoEvent with a plan of their own.
+	// Inherited managed functions already have one from the class that created them, and resolve to the same invoker.
+	for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
 	{
 		UFunction* Func = *It;
 
@@ -291,13 +368,16 @@ void FMonoCompiledClassAsset::AddFunctionsToEventMap(UMonoUnrealClass* Class, UC
 			CurMonoClass = mono_class_get_parent(CurMonoClass);
 		}
 
-		checkf(Method || NativeParentClass->IsChildOf(Func->GetOuterUClass()), 
+		checkf(Method, 
 			TEXT("Could not find method %s for function %s on class %s or its ancestors%s."), 
 			*MonoInvokerName,
 			*FunctionName,
 			ANSI_TO_TCHAR(mono_class_get_name(SearchClass)), 
 			SearchClass == AssetClass ? TEXT("") : *FString::Printf(TEXT(" for derived class %s"), ANSI_TO_TCHAR(mono_class_get_name(AssetClass))));
-		MonoEventMap.Add(Func, Method);
+
+		FMonoEventCallPlan* Plan = new FMonoEventCallPlan(*Func, Method);
+		EventCallPlans.Emplace(Func, TUniquePtr<FMonoEventCallPlan>(Plan));
+		GMonoEventCallPlans.Set(*Func, Plan);
 	}
 
 }
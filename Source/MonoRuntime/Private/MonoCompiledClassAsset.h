@@ -11,6 +11,7 @@
 
 #include <mono/metadata/class.h>
 #include "MonoAssemblyMetadata.h"
+#include "MonoHelpers.h"
 
 class FMonoBindings;
 class UInputComponent;
@@ -21,6 +22,8 @@ class FMonoCompiledClassAsset
 public:
 	static TUniquePtr<FMonoCompiledClassAsset> CreateCompiledClassAsset(FString& ErrorString, FMonoBindings& InBindings, MonoClass* InAssetClass);
 
+	~FMonoCompiledClassAsset();
+
 	void CreateCompanionObject(UObject* NativeObject, const FObjectInitializer& ObjectInitializer) const;
 
 	void InvokeMonoEvent(UObject* Object, FFrame& TheStack, RESULT_DECL);
@@ -43,6 +46,8 @@ public:
 	void AddFunctionsToEventMap(UMonoUnrealClass* Class, UClass* NativeParentClass, const TArray<FMonoFunctionMetadata>& FunctionMetadata);
 
 private:
+	friend class FMonoEventCallPlanTable;
+
 	FMonoCompiledClassAsset(FMonoBindings& InBindings, 
 							MonoClass* InAssetClass, 
 							MonoMethod* InAssetConstructor
@@ -58,5 +63,32 @@ private:
 #if MONO_WITH_HOT_RELOADING
 	MonoMethod* AssetNativeConstructor;
 #endif // MONO_WITH_HOT_RELOADING
-	TMap<UFunction*, MonoMethod*> MonoEventMap;
+	// Invoke_<FunctionName>(IntPtr buffer, IntPtr returnBuffer), generated by MonoAssemblyProcess
+	typedef TMonoThunk<void(MonoObject*, uint8*, void*)> FMonoEventThunk;
+
+	// Everything InvokeMonoEvent needs to know about a UFunction, gathered once when the event map is built
+	// so calls don't have to iterate the function's properties
+	struct FMonoEventCallPlan
+	{
+		struct FOutParam
+		{
+			UProperty* Property;
+			int32 Offset;
+			// FString and TArray out params come back from managed code allocated with CoTaskMemAlloc
+			bool bNeedsCoTaskMemFree;
+		};
+
+		FMonoEventThunk Thunk;
+		// offsets of all parameters in declaration order, for stepping script arguments
+		TArray<int32, TInlineAllocator<8>> ParamOffsets;
+		// out params excluding the return value, in the same order as the stack's out parm records
+		TArray<FOutParam, TInlineAllocator<4>> OutParams;
+		UProperty* ReturnProperty;
+		bool bReturnNeedsCoTaskMemFree;
+
+		FMonoEventCallPlan(UFunction& Function, MonoMethod* Method);
+	};
+
+	// plans for the UFunctions our class created, published to the call plan table by function object index
+	TArray<TPair<UFunction*, TUniquePtr<FMonoEventCallPlan>>> EventCallPlans;
 };
\ No newline at end of file
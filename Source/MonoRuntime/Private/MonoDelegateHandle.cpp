@@ -8,6 +8,7 @@ FMonoDelegateHandle::FMonoDelegateHandle(FMonoBindings& InBindings, MonoObject*
 	: Bindings(InBindings)
 	, TargetObject(OptionalTargetObject)
 	, bTargetObjectBound(nullptr != OptionalTargetObject)
+	, DelegateThunk(nullptr)
 {
 	check(Delegate);
 	check(mono_class_is_delegate(mono_object_get_class(Delegate)));
@@ -22,8 +22,15 @@ public:
 	FMonoDelegateHandle& operator=(const FMonoDelegateHandle&) = delete;
 
 private:
+	// primitive signatures go through an unmanaged thunk of the delegate's Invoke method, everything else through mono_runtime_delegate_invoke
+	template <class ReturnValue, typename... ArgTypes>
+	typename TEnableIf<Mono::ThunkType<ReturnValue>::Value && Mono::AreThunkTypes<ArgTypes...>::Value, ReturnValue>::Type InvokeDelegateObject(MonoObject* DelegateObject, ArgTypes... Arguments);
+	template <class ReturnValue, typename... ArgTypes>
+	typename TEnableIf<!(Mono::ThunkType<ReturnValue>::Value && Mono::AreThunkTypes<ArgTypes...>::Value), ReturnValue>::Type InvokeDelegateObject(MonoObject* DelegateObject, ArgTypes... Arguments);
+
 	FMonoBindings&	 Bindings;
 	TWeakObjectPtr<> TargetObject;
 	uint32_t		 DelegateGCHandle;
 	bool			 bTargetObjectBound;
+	void*			 DelegateThunk;
 };
\ No newline at end of file
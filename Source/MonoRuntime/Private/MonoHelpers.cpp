@@ -235,24 +235,8 @@ namespace Mono
 		MonoObject* Exception = nullptr;
 		MonoObject* ReturnValue = mono_runtime_invoke(Method, Object, Arguments, &Exception);
 
-		bThrewException = nullptr != Exception;
-		if (nullptr == Exception)
-		{
-			return ReturnValue;
-		}
-		else
-		{
-			if (ExceptionBehavior == InvokeExceptionBehavior::OutputToMessageLog)
-			{
-				LogExceptionToMessageLog(Exception);
-			}
-			else
-			{
-				check(ExceptionBehavior == InvokeExceptionBehavior::OutputToLog);
-				mono_print_unhandled_exception(Exception);
-			}
-			return nullptr;
-		}
+		bThrewException = HandleInvokeException(ExceptionBehavior, Exception);
+		return bThrewException ? nullptr : ReturnValue;
 	}
 
 	MonoObject* InvokeDelegate(bool& bThrewException, InvokeExceptionBehavior ExceptionBehavior, MonoDomain* Domain, MonoObject* Delegate, void** Arguments)
@@ -264,24 +248,35 @@ namespace Mono
 		MonoObject* Exception = nullptr;
 		MonoObject* ReturnValue = mono_runtime_delegate_invoke(Delegate, Arguments, &Exception);
 
-		bThrewException = nullptr != Exception;
+		bThrewException = HandleInvokeException(ExceptionBehavior, Exception);
+		return bThrewException ? nullptr : ReturnValue;
+	}
+
+	bool HandleInvokeException(InvokeExceptionBehavior ExceptionBehavior, MonoObject* Exception)
+	{
 		if (nullptr == Exception)
 		{
-			return ReturnValue;
+			return false;
+		}
+
+		if (ExceptionBehavior == InvokeExceptionBehavior::OutputToMessageLog)
+		{
+			LogExceptionToMessageLog(Exception);
 		}
 		else
 		{
-			if (ExceptionBehavior == InvokeExceptionBehavior::OutputToMessageLog)
-			{
-				LogExceptionToMessageLog(Exception);
-			}
-			else
-			{
-				check(ExceptionBehavior == InvokeExceptionBehavior::OutputToLog);
-				mono_print_unhandled_exception(Exception);
-			}
-			return nullptr;
+			check(ExceptionBehavior == InvokeExceptionBehavior::OutputToLog);
+			mono_print_unhandled_exception(Exception);
 		}
+		return true;
+	}
+
+	void* GetUnmanagedThunk(MonoMethod* Method)
+	{
+		check(Method);
+		void* Thunk = mono_method_get_unmanaged_thunk(Method);
+		checkf(Thunk, TEXT("Could not create unmanaged thunk for method %s"), ANSI_TO_TCHAR(mono_method_get_name(Method)));
+		return Thunk;
 	}
 
 	MonoObject* ConstructObject(const FMonoDomain& Domain, MonoClass* Class)
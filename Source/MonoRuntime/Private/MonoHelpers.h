@@ -9,6 +9,7 @@
 #include "UObject/CoreNet.h"
 #include "UObject/Object.h"
 #include "Templates/EnableIf.h"
+#include "Templates/Atomic.h"
 #include "Templates/UnrealTypeTraits.h"
 #include "Components/InputComponent.h"
 
@@ -582,6 +583,200 @@ namespace Mono
 		return Marshal<ReturnValue>::ReturnValue(Domain, ReturnObject);
 	}
 
+	// Unmanaged thunks
+	// mono_method_get_unmanaged_thunk gives us a native function pointer which calls straight into the jitted method,
+	// skipping the argument boxing and generic trampoline of mono_runtime_invoke. Arguments are passed raw, so thunks are
+	// only used for signatures made up of primitives, enums and object references.
+#if PLATFORM_WINDOWS
+#define MONO_THUNK_CALL __stdcall
+#else
+#define MONO_THUNK_CALL
+#endif
+
+	// raw pointers which thunks pass as IntPtr
+	template <class T>
+	struct ThunkPointerType : public FalseType
+	{
+	};
+
+	template <>
+	struct ThunkPointerType<void*> : public TrueType
+	{
+	};
+
+	template <>
+	struct ThunkPointerType<uint8*> : public TrueType
+	{
+	};
+
+	// types which can be passed through a thunk without marshaling, used to pick thunks over mono_runtime_invoke for delegates
+	template <class T>
+	struct ThunkType
+	{
+		static const bool Value = ValueType<T>::Value || TIsEnum<T>::Value || PassThroughType<T>::Value || ThunkPointerType<T>::Value;
+	};
+
+	template <>
+	struct ThunkType<void> : public TrueType
+	{
+	};
+
+	template <typename... ArgTypes>
+	struct AreThunkTypes : public TrueType
+	{
+	};
+
+	template <typename ArgType, typename... ArgTypes>
+	struct AreThunkTypes<ArgType, ArgTypes...>
+	{
+		static const bool Value = ThunkType<ArgType>::Value && AreThunkTypes<ArgTypes...>::Value;
+	};
+
+	// Explicitly typed thunks may also take a UObject* for an IntPtr native object parameter, e.g. wrapper constructors.
+	// Delegates don't qualify, their UObject parameters need to be marshaled to wrappers.
+	template <typename... ArgTypes>
+	struct AreExplicitThunkArgTypes : public TrueType
+	{
+	};
+
+	template <typename ArgType, typename... ArgTypes>
+	struct AreExplicitThunkArgTypes<ArgType, ArgTypes...>
+	{
+		static const bool Value = (ThunkType<ArgType>::Value || TAreTypesEqual<ArgType, UObject*>::Value) && AreExplicitThunkArgTypes<ArgTypes...>::Value;
+	};
+
+	// compiles the thunk for Method in the current domain, returns an untyped function pointer
+	void* GetUnmanagedThunk(MonoMethod* Method);
+	// logs Exception according to ExceptionBehavior, returns true if there was an exception
+	MONORUNTIME_API bool HandleInvokeException(InvokeExceptionBehavior ExceptionBehavior, MonoObject* Exception);
+
+	template <class ReturnValue>
+	struct ThunkCall
+	{
+		template <typename FunctionPtr, typename... ArgTypes>
+		static inline ReturnValue Call(bool& bThrewException, InvokeExceptionBehavior ExceptionBehavior, FunctionPtr Function, ArgTypes... Arguments)
+		{
+			MonoException* Exception = nullptr;
+			ReturnValue Result = Function(Arguments..., &Exception);
+			bThrewException = HandleInvokeException(ExceptionBehavior, (MonoObject*)Exception);
+			return bThrewException ? ReturnValue() : Result;
+		}
+	};
+
+	template <>
+	struct ThunkCall<void>
+	{
+		template <typename FunctionPtr, typename... ArgTypes>
+		static inline void Call(bool& bThrewException, InvokeExceptionBehavior ExceptionBehavior, FunctionPtr Function, ArgTypes... Arguments)
+		{
+			MonoException* Exception = nullptr;
+			Function(Arguments..., &Exception);
+			bThrewException = HandleInvokeException(ExceptionBehavior, (MonoObject*)Exception);
+		}
+	};
+}
+
+// Typed, lazily compiled unmanaged thunk for a single MonoMethod.
+// For instance methods the first argument is the MonoObject* this, exactly as mono expects it.
+// Like mono_runtime_invoke, the method is called as is, without virtual dispatch.
+// Thunks may be invoked from any thread which is attached to mono, the compiled function pointer is published atomically.
+template <typename FunctionType>
+class TMonoThunk;
+
+template <typename ReturnValue, typename... ArgTypes>
+class TMonoThunk<ReturnValue(ArgTypes...)>
+{
+	static_assert(Mono::ThunkType<ReturnValue>::Value && Mono::AreExplicitThunkArgTypes<ArgTypes...>::Value, "Unmanaged thunks only support primitive, enum, IntPtr and object reference types");
+
+public:
+	typedef ReturnValue (MONO_THUNK_CALL *FunctionPtr)(ArgTypes..., MonoException**);
+
+	TMonoThunk()
+		: Method(nullptr)
+		, Function(nullptr)
+	{
+	}
+
+	explicit TMonoThunk(MonoMethod* InMethod)
+		: Method(InMethod)
+		, Function(nullptr)
+	{
+#if DO_GUARD_SLOW
+		if (nullptr != Method)
+		{
+			MonoMethodSignature* Signature = mono_method_signature(Method);
+			check(Signature);
+			check(mono_signature_get_param_count(Signature) + (mono_signature_is_instance(Signature) ? 1 : 0) == sizeof...(ArgTypes));
+		}
+#endif // DO_GUARD_SLOW
+	}
+
+	TMonoThunk(const TMonoThunk& Other)
+		: Method(Other.Method)
+		, Function(Other.Function.Load())
+	{
+	}
+
+	TMonoThunk& operator=(const TMonoThunk& Other)
+	{
+		Method = Other.Method;
+		Function = Other.Function.Load();
+		return *this;
+	}
+
+	bool IsBound() const { return nullptr != Method; }
+	MonoMethod* GetMethod() const { return Method; }
+
+	// compiles the thunk now instead of on first use, so copies made afterwards share the compiled pointer
+	void Compile() const
+	{
+		check(Method);
+		if (nullptr == Function.Load())
+		{
+			Function = Mono::GetUnmanagedThunk(Method);
+		}
+	}
+
+	template <class DomainType>
+	ReturnValue Invoke(const DomainType& Domain, ArgTypes... Arguments) const
+	{
+		bool bThrewException = false;
+		return Invoke(bThrewException, Domain, Arguments...);
+	}
+
+	template <class DomainType>
+	ReturnValue Invoke(bool& bThrewException, const DomainType& Domain, ArgTypes... Arguments) const
+	{
+		check(Method);
+		void* CompiledFunction = Function.Load();
+		if (nullptr == CompiledFunction)
+		{
+			// compiling the thunk is deferred to first use, racing threads will both end up with the same pointer
+			CompiledFunction = Mono::GetUnmanagedThunk(Method);
+			Function = CompiledFunction;
+		}
+		return InvokeFunction(bThrewException, Domain, (FunctionPtr)CompiledFunction, Arguments...);
+	}
+
+	// for callers which cache the untyped pointer from Mono::GetUnmanagedThunk themselves
+	template <class DomainType>
+	static ReturnValue InvokeFunction(bool& bThrewException, const DomainType& Domain, FunctionPtr InFunction, ArgTypes... Arguments)
+	{
+		check(InFunction);
+#if MONO_WITH_HOT_RELOADING
+		mono_domain_set(Domain.GetDomain(), false);
+#endif // MONO_WITH_HOT_RELOADING
+		return Mono::ThunkCall<ReturnValue>::Call(bThrewException, Domain.GetExceptionBehavior(), InFunction, Arguments...);
+	}
+
+private:
+	MonoMethod* Method;
+	// the untyped pointer from Mono::GetUnmanagedThunk
+	mutable TAtomic<void*> Function;
+};
+
+namespace Mono
+{
 	// Object creation
 	// construct object calling default constructor
 	MonoObject* ConstructObject(const FMonoDomain& Domain, MonoClass* Class);
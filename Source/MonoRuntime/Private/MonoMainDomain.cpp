@@ -13,6 +13,8 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeCounter.h"
 
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
@@ -20,6 +22,18 @@
 
 void MonoRegisterDllImportMappings();
 
+static int32 GMonoForceJIT = 0;
+static FAutoConsoleVariableRef CVarMonoForceJIT(
+	TEXT("MonoRuntime.ForceJIT"),
+	GMonoForceJIT,
+	TEXT("If non-zero, precompiled AOT images next to managed assemblies are ignored and all managed code is JIT compiled.\n")
+	TEXT("Only read when the runtime starts, -MonoForceJIT on the command line does the same."),
+	ECVF_ReadOnly);
+
+// number of assemblies loaded with an up to date AOT image next to them. Mono doesn't report whether it actually used
+// an image, so this only says one was there for it. Assemblies can be preloaded from any thread.
+static FThreadSafeCounter MonoNumAotImagesFound;
+
 FMonoMainDomain::FMonoMainDomain(MonoDomain* InDomain, const FString& InEngineAssemblyDirectory, const FString& InGameAssemblyDirectory)
 	: FMonoDomain(InDomain, Mono::InvokeExceptionBehavior::OutputToLog)
 	, EngineAssemblyDirectory(InEngineAssemblyDirectory)
@@ -77,6 +91,42 @@ struct AssemblySearchPath {
 
 static TArray<AssemblySearchPath> MonoPreloadSearchPaths;
 
+// Mono looks for an assembly's AOT image at the assembly path plus the platform's shared library extension
+static FString GetAotImagePath(const FString& AsmPath)
+{
+#if PLATFORM_WINDOWS
+	return AsmPath + TEXT(".dll");
+#elif PLATFORM_MAC || PLATFORM_IOS
+	return AsmPath + TEXT(".dylib");
+#else
+	return AsmPath + TEXT(".so");
+#endif
+}
+
+static bool HasUsableAotImage(const FString& AsmPath)
+{
+	if (GMonoForceJIT)
+	{
+		return false;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString AotPath = GetAotImagePath(AsmPath);
+	const FDateTime AotTimeStamp = FileManager.GetTimeStamp(*AotPath);
+	if (AotTimeStamp == FDateTime::MinValue())
+	{
+		return false;
+	}
+
+	// mono rejects images built from a different assembly anyway, this just makes the reason visible
+	if (AotTimeStamp < FileManager.GetTimeStamp(*AsmPath))
+	{
+		UE_LOG(LogMono, Warning, TEXT("AOT image '%s' is older than its assembly and will be ignored, rebuild with MonoUEAot enabled."), *AotPath);
+		return false;
+	}
+	return true;
+}
+
 inline bool SizeAndMtimeEqual(FFileStatData a, FFileStatData b)
 {
 	return a.ModificationTime == b.ModificationTime && a.FileSize == b.FileSize;
@@ -87,8 +137,10 @@ static FString ShadowCopyAssembly(const FString& AsmPath, const FString& AsmName
 	IFileManager& FileManager = IFileManager::Get();
 
 	FString PdbPath = FPaths::ChangeExtension(AsmPath, TEXT(".pdb"));
+	FString AotPath = GetAotImagePath(AsmPath);
 	FFileStatData AsmStat = FileManager.GetStatData(*AsmPath);
 	FFileStatData PdbStat = FileManager.GetStatData(*PdbPath);
+	FFileStatData AotStat = HasUsableAotImage(AsmPath) ? FileManager.GetStatData(*AotPath) : FFileStatData();
 
 	for (int i = 0; i < 20; i++)
 	{
@@ -99,18 +151,21 @@ static FString ShadowCopyAssembly(const FString& AsmPath, const FString& AsmName
 		}
 		FString ShadowAsmPath = FPaths::Combine(ShadowCopyDirectory, *AsmName);
 		FString ShadowPdbPath = FPaths::ChangeExtension(ShadowAsmPath, TEXT(".pdb"));
+		FString ShadowAotPath = GetAotImagePath(ShadowAsmPath);
 
 		FFileStatData ShadowAsmStat = FileManager.GetStatData(*ShadowAsmPath);
 		FFileStatData ShadowPdbStat = FileManager.GetStatData(*ShadowPdbPath);
+		FFileStatData ShadowAotStat = FileManager.GetStatData(*ShadowAotPath);
 		if (ShadowAsmStat.bIsValid)
 		{
-			if (SizeAndMtimeEqual (ShadowAsmStat, AsmStat) && (!PdbStat.bIsValid  || SizeAndMtimeEqual (ShadowPdbStat, PdbStat)))
+			if (SizeAndMtimeEqual (ShadowAsmStat, AsmStat) && (!PdbStat.bIsValid  || SizeAndMtimeEqual (ShadowPdbStat, PdbStat))
+				&& (AotStat.bIsValid ? SizeAndMtimeEqual (ShadowAotStat, AotStat) : !ShadowAotStat.bIsValid))
 			{
 				UE_LOG(LogMono, Log, TEXT("Re-using existing shadow copy '%s'."), *ShadowAsmPath);
 				return ShadowAsmPath;
 			}
 
-			if (!FileManager.Delete(*ShadowAsmPath, false, false, true) || !FileManager.Delete(*ShadowPdbPath, false, false, true))
+			if (!FileManager.Delete(*ShadowAsmPath, false, false, true) || !FileManager.Delete(*ShadowPdbPath, false, false, true) || !FileManager.Delete(*ShadowAotPath, false, false, true))
 			{
 				UE_LOG(LogMono, Log, TEXT("Ignoring locked shadow copy '%s'."), *ShadowAsmPath);
 				continue;
@@ -134,6 +189,17 @@ static FString ShadowCopyAssembly(const FString& AsmPath, const FString& AsmName
 			}
 		}
 
+		// mono only finds the AOT image next to the path it loaded the assembly from
+		if (AotStat.bIsValid)
+		{
+			uint32 AotCopyResult = FileManager.Copy(*ShadowAotPath, *AotPath);
+			if (AotCopyResult != COPY_OK)
+			{
+				UE_LOG(LogMono, Error, TEXT("Failed to shadow copy AOT image to '%s' (code %u), loading original assembly."), *ShadowAotPath, AotCopyResult);
+				return AsmPath;
+			}
+		}
+
 		UE_LOG(LogMono, Log, TEXT("Shadow copied assembly to '%s'."), *ShadowAsmPath);
 
 		return ShadowAsmPath;
@@ -191,7 +257,15 @@ assembly_preload_hook(MonoAssemblyName *aname, char **assemblies_path, void* use
 		MonoAssembly *loaded_asm = mono_assembly_open(TCHAR_TO_ANSI(*AbsoluteAssemblyPath), &status);
 		if (loaded_asm)
 		{
-			UE_LOG(LogMono, Log, TEXT("Loaded assembly from path '%s'."), *AbsoluteAssemblyPath);
+			if (HasUsableAotImage(AbsoluteAssemblyPath))
+			{
+				MonoNumAotImagesFound.Increment();
+				UE_LOG(LogMono, Log, TEXT("Loaded assembly from path '%s' with AOT image."), *AbsoluteAssemblyPath);
+			}
+			else
+			{
+				UE_LOG(LogMono, Log, TEXT("Loaded assembly from path '%s'."), *AbsoluteAssemblyPath);
+			}
 			return loaded_asm;
 		}
 
@@ -314,6 +388,21 @@ FMonoMainDomain* FMonoMainDomain::CreateMonoJIT(const FString& MonoRuntimeDirect
 
 #endif
 
+	if (FParse::Param(FCommandLine::Get(), TEXT("MonoForceJIT")))
+	{
+		GMonoForceJIT = 1;
+	}
+
+	// AOT images are used automatically when mono finds one next to an assembly, unless its "aot" optimization is turned off
+	if (GMonoForceJIT)
+	{
+		char ForceJITOption[] = "--optimize=-aot";
+		char* Options[] = { ForceJITOption };
+		mono_jit_parse_options(ARRAY_COUNT(Options), Options);
+
+		UE_LOG(LogMono, Log, TEXT("AOT images disabled, all managed code will be JIT compiled."));
+	}
+
 	MonoDomain* MainDomain = mono_jit_init_version(TCHAR_TO_ANSI(FApp::GetProjectName()), "mobile");
 	check(MainDomain);
 
@@ -328,6 +417,16 @@ FMonoMainDomain* FMonoMainDomain::CreateMonoJIT(const FString& MonoRuntimeDirect
 	return new FMonoMainDomain(MainDomain, InEngineAssemblyDirectory, InGameAssemblyDirectory);
 }
 
+int32 FMonoMainDomain::GetNumAotImagesFound()
+{
+	return MonoNumAotImagesFound.GetValue();
+}
+
+bool FMonoMainDomain::IsJITForced()
+{
+	return GMonoForceJIT != 0;
+}
+
 MonoDomain* FMonoMainDomain::CreateGameDomain()
 {
 	MonoDomain* GameDomain = mono_domain_create_appdomain((char*)"foo", nullptr);
@@ -19,6 +19,11 @@ public:
 
 	static FString GetConfigurationSpecificSubdirectory(const FString &ParentDirectory);
 
+	// Number of assemblies loaded so far with an up to date AOT image next to them. Mono doesn't report whether it loaded the image.
+	static int32 GetNumAotImagesFound();
+	// Whether AOT images are being ignored, see MonoRuntime.ForceJIT
+	static bool IsJITForced();
+
 #if MONOUE_STANDALONE
 	bool Loaded;
 #endif
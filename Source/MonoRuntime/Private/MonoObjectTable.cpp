@@ -9,9 +9,13 @@
 #include "GameFramework/Actor.h"
 #include "Components/ActorComponent.h"
 #include "Stats/StatsMisc.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
 #include "Engine/World.h"
 #include "UObject/Object.h"
 #include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
 
 #include "MonoRuntimeCommon.h"
 #include "MonoHelpers.h"
@@ -19,26 +23,74 @@
 
 #include <mono/metadata/mono-gc.h>
 
+static int32 GMonoIncrementalGC = 1;
+static FAutoConsoleVariableRef CVarMonoIncrementalGC(
+	TEXT("MonoRuntime.GC.Incremental"),
+	GMonoIncrementalGC,
+	TEXT("If non-zero, unreal GCs only run a managed nursery collection unless a companion may have died, or a major collection is due.\n")
+	TEXT("If zero, every unreal GC forces a full managed collection."),
+	ECVF_Default);
+
+static int32 GMonoMajorGCInterval = 10;
+static FAutoConsoleVariableRef CVarMonoMajorGCInterval(
+	TEXT("MonoRuntime.GC.MajorCollectionInterval"),
+	GMonoMajorGCInterval,
+	TEXT("When incremental managed GC is enabled, force a full managed collection after this many unreal GCs (0 disables the cadence)."),
+	ECVF_Default);
+
+static float GMonoMajorGCHeapGrowthPercent = 50.0f;
+static FAutoConsoleVariableRef CVarMonoMajorGCHeapGrowthPercent(
+	TEXT("MonoRuntime.GC.MajorCollectionHeapGrowthPercent"),
+	GMonoMajorGCHeapGrowthPercent,
+	TEXT("When incremental managed GC is enabled, force a full managed collection once the managed heap has grown by this percentage since the last one (0 disables the threshold)."),
+	ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GC Handle Allocations Per GC"), STAT_MonoGCHandleAllocationsPerGC, STATGROUP_Mono);
+
+// running count of GC handles allocated by the object table, sampled around each unreal GC
+static FThreadSafeCounter GMonoGCHandleAllocations;
+
+namespace
+{
+	// initial number of slots in the companion root array
+	const int32 CompanionRootPoolInitialCapacity = 1024;
+
+	// number of table slots classified by each task in the parallel GC sweeps
+	const int32 TraceSweepChunkSize = 4096;
+
+	// per task results of a GC sweep, applied serially since they call into mono
+	struct FTraceSweepChunk
+	{
+		TArray<int32> DeadIndices;
+		TArray<int32> CompanionIndices;
+	};
+}
+
 FMonoObjectHandle::FMonoObjectHandle()
 	: GCHandle(0)
+	, RootIndex(INDEX_NONE)
 	, State(EMonoObjectHandleState::Reset)
 {
 
 }
 
 FMonoObjectHandle::FMonoObjectHandle(FMonoObjectHandle&& Other)
+	: GCHandle(Other.GCHandle.Exchange(0))
 {
-	GCHandle = Other.GCHandle;
-	Other.GCHandle = 0;
+	RootIndex = Other.RootIndex;
+	Other.RootIndex = INDEX_NONE;
 	State = Other.State;
 	Other.State = EMonoObjectHandleState::Reset;
 }
 
-FMonoObjectHandle::FMonoObjectHandle(MonoObject* TargetObject, bool InIsCompanion)
-	: GCHandle(InIsCompanion ? mono_gchandle_new(TargetObject, false) : mono_gchandle_new_weakref(TargetObject, false))
+FMonoObjectHandle::FMonoObjectHandle(MonoObject* TargetObject, bool InIsCompanion, int32 InRootIndex)
+	: GCHandle(mono_gchandle_new_weakref(TargetObject, false))
+	, RootIndex(InRootIndex)
 	, State(InIsCompanion ? EMonoObjectHandleState::Companion_Alive : EMonoObjectHandleState::Wrapper)
 {
-
+	// companions have a strong ref to their managed object through the root pool
+	check(InIsCompanion == (InRootIndex != INDEX_NONE));
+	GMonoGCHandleAllocations.Increment();
 }
 
 FMonoObjectHandle::~FMonoObjectHandle()
@@ -54,8 +106,9 @@ FMonoObjectHandle& FMonoObjectHandle::operator=(FMonoObjectHandle&& Other)
 	}
 
 	Reset();
-	GCHandle = Other.GCHandle;
-	Other.GCHandle = 0;
+	GCHandle = Other.GCHandle.Exchange(0);
+	RootIndex = Other.RootIndex;
+	Other.RootIndex = INDEX_NONE;
 	State = Other.State;
 	Other.State = EMonoObjectHandleState::Reset;
 
@@ -65,8 +118,9 @@ FMonoObjectHandle& FMonoObjectHandle::operator=(FMonoObjectHandle&& Other)
 MonoObject* FMonoObjectHandle::GetTargetObject() const
 {
 	check(State != EMonoObjectHandleState::Reset);
-	check(GCHandle != 0);
-	return mono_gchandle_get_target(GCHandle);
+	const uint32_t CurrentGCHandle = GCHandle;
+	check(CurrentGCHandle != 0);
+	return mono_gchandle_get_target(CurrentGCHandle);
 }
 
 bool FMonoObjectHandle::IsWrapper() const
@@ -80,57 +134,607 @@ bool FMonoObjectHandle::IsCompanion() const
 	return State == EMonoObjectHandleState::Companion_Alive || State == EMonoObjectHandleState::Companion_PossiblyDead;
 }
 
-void FMonoObjectHandle::MarkCompanionAsPossiblyDead()
+void FMonoObjectHandle::MarkCompanionAsPossiblyDead(FMonoCompanionRootPool& CompanionRoots)
 {
 	check(State == EMonoObjectHandleState::Companion_Alive);
 
-	// switch to weak handle
-	MonoObject* Target = GetTargetObject();
-	check(nullptr != Target);
-	uint32_t NewWeakGCHandle = mono_gchandle_new_weakref(Target, false);
-	check(GCHandle != 0);
-	mono_gchandle_free(GCHandle);
-	GCHandle = NewWeakGCHandle;
+	// unroot it, only our weak handle is left
+	CompanionRoots.Set(RootIndex, nullptr);
 
 	State = EMonoObjectHandleState::Companion_PossiblyDead;
 }
 
-void FMonoObjectHandle::MarkCompanionAsAlive()
+void FMonoObjectHandle::MarkCompanionAsAlive(FMonoCompanionRootPool& CompanionRoots)
 {
 	if (State != EMonoObjectHandleState::Companion_Alive)
 	{
 		check(State == EMonoObjectHandleState::Companion_PossiblyDead);
-		// switch back to strong handle
+		// root it again
 		MonoObject* Target = GetTargetObject();
 		check(nullptr != Target);
-		uint32_t NewStrongGCHandle = mono_gchandle_new(Target, false);
-		check(GCHandle != 0);
-		mono_gchandle_free(GCHandle);
-		GCHandle = NewStrongGCHandle;
+		CompanionRoots.Set(RootIndex, Target);
 
 		State = EMonoObjectHandleState::Companion_Alive;
 	}
 }
 
+uint32_t FMonoObjectHandle::ReleaseGCHandle()
+{
+	check(State != EMonoObjectHandleState::Reset);
+	const uint32_t ReleasedGCHandle = GCHandle.Exchange(0);
+	State = EMonoObjectHandleState::Reset;
+	return ReleasedGCHandle;
+}
+
 void FMonoObjectHandle::Reset()
 {
-	if (GCHandle != 0)
+	const uint32_t OldGCHandle = GCHandle.Exchange(0);
+	if (OldGCHandle != 0)
 	{
-		check(State != EMonoObjectHandleState::Reset);
-		mono_gchandle_free(GCHandle);
-		GCHandle = 0;
+		// handles published by another thread have no state until the game thread adopts them
+		mono_gchandle_free(OldGCHandle);
 		State = EMonoObjectHandleState::Reset;
 	}
 	else
 	{
 		check(State == EMonoObjectHandleState::Reset);
 	}
+	RootIndex = INDEX_NONE;
+
+}
+
+FMonoCompanionRootPool::FMonoCompanionRootPool()
+	: Domain(nullptr)
+	, ArrayGCHandle(0)
+	, Capacity(0)
+	, NumAllocated(0)
+{
+
+}
+
+FMonoCompanionRootPool::FMonoCompanionRootPool(FMonoCompanionRootPool&& Other)
+	: Domain(nullptr)
+	, ArrayGCHandle(0)
+	, Capacity(0)
+	, NumAllocated(0)
+{
+	*this = MoveTemp(Other);
+}
+
+FMonoCompanionRootPool::~FMonoCompanionRootPool()
+{
+	Empty();
+}
+
+FMonoCompanionRootPool& FMonoCompanionRootPool::operator=(FMonoCompanionRootPool&& Other)
+{
+	if (this == &Other)
+	{
+		return *this;
+	}
+
+	Empty();
+
+	Domain = Other.Domain;
+	Other.Domain = nullptr;
+	ArrayGCHandle = Other.ArrayGCHandle;
+	Other.ArrayGCHandle = 0;
+	Capacity = Other.Capacity;
+	Other.Capacity = 0;
+	NumAllocated = Other.NumAllocated;
+	Other.NumAllocated = 0;
+	FreeSlots = MoveTemp(Other.FreeSlots);
+	Other.FreeSlots.Empty();
+
+	return *this;
+}
+
+void FMonoCompanionRootPool::Initialize(MonoDomain* InDomain)
+{
+	check(InDomain);
+	check(ArrayGCHandle == 0);
+	Domain = InDomain;
+}
+
+int32 FMonoCompanionRootPool::Add(MonoObject* Target)
+{
+	check(Target);
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(false);
+	}
+	else
+	{
+		if (NumAllocated == Capacity)
+		{
+			Grow();
+		}
+		SlotIndex = NumAllocated++;
+	}
+
+	Set(SlotIndex, Target);
+	return SlotIndex;
+}
+
+void FMonoCompanionRootPool::Remove(int32 SlotIndex)
+{
+	Set(SlotIndex, nullptr);
+	FreeSlots.Add(SlotIndex);
+}
+
+void FMonoCompanionRootPool::Set(int32 SlotIndex, MonoObject* Target)
+{
+	check(SlotIndex >= 0 && SlotIndex < NumAllocated);
+	mono_array_setref(GetArray(), SlotIndex, Target);
+}
+
+void FMonoCompanionRootPool::Empty()
+{
+	if (ArrayGCHandle != 0)
+	{
+		mono_gchandle_free(ArrayGCHandle);
+		ArrayGCHandle = 0;
+	}
+	Capacity = 0;
+	NumAllocated = 0;
+	FreeSlots.Empty();
+}
+
+MonoArray* FMonoCompanionRootPool::GetArray() const
+{
+	check(ArrayGCHandle != 0);
+	return (MonoArray*)mono_gchandle_get_target(ArrayGCHandle);
+}
+
+void FMonoCompanionRootPool::Grow()
+{
+	check(Domain);
+
+	const int32 NewCapacity = FMath::Max(Capacity * 2, CompanionRootPoolInitialCapacity);
+	MonoArray* NewArray = mono_array_new(Domain, mono_get_object_class(), NewCapacity);
+
+	if (ArrayGCHandle != 0)
+	{
+		MonoArray* OldArray = GetArray();
+		for (int32 i = 0; i < NumAllocated; ++i)
+		{
+			mono_array_setref(NewArray, i, mono_array_get(OldArray, MonoObject*, i));
+		}
+		mono_gchandle_free(ArrayGCHandle);
+	}
+
+	ArrayGCHandle = mono_gchandle_new((MonoObject*)NewArray, false);
+	GMonoGCHandleAllocations.Increment();
+	Capacity = NewCapacity;
+}
+
+FMonoObjectHandleTable::FMonoObjectHandleTable()
+	: NumOccupied(0)
+{
+	for (TAtomic<FMonoObjectHandle*>& Page : Pages)
+	{
+		Page = nullptr;
+	}
+}
+
+FMonoObjectHandleTable::FMonoObjectHandleTable(FMonoObjectHandleTable&& Other)
+	: NumOccupied(0)
+{
+	for (TAtomic<FMonoObjectHandle*>& Page : Pages)
+	{
+		Page = nullptr;
+	}
+	*this = MoveTemp(Other);
+}
+
+FMonoObjectHandleTable::~FMonoObjectHandleTable()
+{
+	Empty();
+}
+
+FMonoObjectHandleTable& FMonoObjectHandleTable::operator=(FMonoObjectHandleTable&& Other)
+{
+	if (this == &Other)
+	{
+		return *this;
+	}
+
+	Empty();
+
+	// the owning object table settles anything other threads published into the other table before it is moved
+	check(Other.ConcurrentlyPublishedSlots.IsEmpty());
+	Other.ReclaimRetiredGCHandles();
+
+	for (int32 PageIndex = 0; PageIndex < MaxPages; ++PageIndex)
+	{
+		Pages[PageIndex] = Other.Pages[PageIndex].Exchange(nullptr);
+	}
+	Occupied = MoveTemp(Other.Occupied);
+	NumOccupied = Other.NumOccupied;
+	CompanionRoots = MoveTemp(Other.CompanionRoots);
+	RetiredGCHandles = MoveTemp(Other.RetiredGCHandles);
+
+	Other.Occupied.Empty();
+	Other.NumOccupied = 0;
+	Other.RetiredGCHandles.Empty();
+
+	return *this;
+}
+
+FMonoObjectHandle* FMonoObjectHandleTable::Find(const UObject& InObject)
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	return IsOccupied(Index) ? FindSlot(Index) : nullptr;
+}
+
+const FMonoObjectHandle* FMonoObjectHandleTable::Find(const UObject& InObject) const
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	return IsOccupied(Index) ? FindSlot(Index) : nullptr;
+}
+
+FMonoObjectHandle& FMonoObjectHandleTable::Add(const UObject& InObject, FMonoObjectHandle&& InHandle, uint32_t& OutReplacedGCHandle)
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	check(Index >= 0);
+	check(!IsOccupied(Index));
+
+	FMonoObjectHandle& Slot = FindOrAddSlot(Index);
+
+	// only wrappers are published from other threads. One may have been published since the caller adopted,
+	// its queued publication is skipped when adopted since the slot no longer holds its handle
+	OutReplacedGCHandle = Slot.GCHandle.Exchange(InHandle.GCHandle);
+
+	InHandle.GCHandle = 0;
+	Slot.RootIndex = InHandle.RootIndex;
+	InHandle.RootIndex = INDEX_NONE;
+	Slot.State = InHandle.State;
+	InHandle.State = EMonoObjectHandleState::Reset;
+
+	MarkOccupied(Index);
+
+	return Slot;
+}
+
+void FMonoObjectHandleTable::Remove(const UObject& InObject)
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	if (IsOccupied(Index))
+	{
+		RemoveAt(Index);
+	}
+}
+
+void FMonoObjectHandleTable::Empty()
+{
+	// nothing may be reading the table while it is emptied, so pending handles can be freed right away
+	// published handles are still in their slots and are freed with the pages
+	FConcurrentPublication Publication;
+	while (ConcurrentlyPublishedSlots.Dequeue(Publication))
+	{
+	}
+	uint32_t RetiredGCHandle;
+	while (ConcurrentlyRetiredGCHandles.Dequeue(RetiredGCHandle))
+	{
+		RetiredGCHandles.Add(RetiredGCHandle);
+	}
+	for (uint32_t GCHandle : RetiredGCHandles)
+	{
+		mono_gchandle_free(GCHandle);
+	}
+	RetiredGCHandles.Empty();
+
+	// frees the GC handles still in the table
+	FreePages();
+
+	Occupied.Empty();
+	NumOccupied = 0;
+	CompanionRoots.Empty();
+}
+
+MonoObject* FMonoObjectHandleTable::GetManagedObjectConcurrent(const UObject& InObject) const
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	MonoObject* ManagedObject = nullptr;
+
+	ConcurrentReaders.Increment();
+	const FMonoObjectHandle* Slot = FindSlot(Index);
+	if (nullptr != Slot)
+	{
+		const uint32_t GCHandle = Slot->GCHandle.Load();
+		if (GCHandle != 0)
+		{
+			ManagedObject = mono_gchandle_get_target(GCHandle);
+		}
+	}
+	ConcurrentReaders.Decrement();
+
+	return ManagedObject;
+}
+
+MonoObject* FMonoObjectHandleTable::PublishWrapperObject(const UObject& InObject, MonoObject* WrapperObject)
+{
+	check(WrapperObject);
+	const int32 Index = GUObjectArray.ObjectToIndex(&InObject);
+	check(Index >= 0);
+
+	FMonoObjectHandle& Slot = FindOrAddSlot(Index);
+	const uint32_t NewGCHandle = mono_gchandle_new_weakref(WrapperObject, false);
+	GMonoGCHandleAllocations.Increment();
+
+	MonoObject* Result = WrapperObject;
+	uint32_t ReplacedGCHandle = 0;
+	bool bPublished = false;
+
+	ConcurrentReaders.Increment();
+	for (;;)
+	{
+		uint32_t ExpectedGCHandle = Slot.GCHandle.Load();
+		if (ExpectedGCHandle != 0)
+		{
+			// someone else got there first, use theirs if it's still alive
+			MonoObject* ExistingObject = mono_gchandle_get_target(ExpectedGCHandle);
+			if (nullptr != ExistingObject)
+			{
+				Result = ExistingObject;
+				break;
+			}
+		}
+		if (Slot.GCHandle.CompareExchange(ExpectedGCHandle, NewGCHandle))
+		{
+			ReplacedGCHandle = ExpectedGCHandle;
+			bPublished = true;
+			break;
+		}
+	}
+	ConcurrentReaders.Decrement();
+
+	if (!bPublished)
+	{
+		// nobody else ever saw this handle
+		mono_gchandle_free(NewGCHandle);
+		return Result;
+	}
+
+	if (IsInGameThread())
+	{
+		if (ReplacedGCHandle != 0)
+		{
+			RetireGCHandle(ReplacedGCHandle);
+		}
+		// any queued publication for this slot has been replaced, and is skipped when adopted
+		AdoptSlot(Index);
+	}
+	else
+	{
+		if (ReplacedGCHandle != 0)
+		{
+			ConcurrentlyRetiredGCHandles.Enqueue(ReplacedGCHandle);
+		}
+		FConcurrentPublication Publication;
+		Publication.Index = Index;
+		Publication.SerialNumber = GUObjectArray.AllocateSerialNumber(Index);
+		Publication.GCHandle = NewGCHandle;
+		ConcurrentlyPublishedSlots.Enqueue(Publication);
+	}
+
+	return Result;
+}
+
+void FMonoObjectHandleTable::AdoptConcurrentlyPublished(TArray<uint32_t>& OutStaleGCHandles)
+{
+	check(IsInGameThread());
+	FConcurrentPublication Publication;
+	while (ConcurrentlyPublishedSlots.Dequeue(Publication))
+	{
+		FMonoObjectHandle& Slot = *FindSlot(Publication.Index);
+		if (Slot.GCHandle.Load() != Publication.GCHandle)
+		{
+			// replaced or removed before it was adopted, whoever did that took care of the handle
+			continue;
+		}
+
+		if (GUObjectArray.GetSerialNumber(Publication.Index) != Publication.SerialNumber)
+		{
+			// the object was destroyed and its index reused before we got here, don't attach the wrapper to the new object
+			uint32_t ExpectedGCHandle = Publication.GCHandle;
+			if (Slot.GCHandle.CompareExchange(ExpectedGCHandle, 0))
+			{
+				OutStaleGCHandles.Add(Publication.GCHandle);
+			}
+			continue;
+		}
+
+		AdoptSlot(Publication.Index);
+	}
+}
+
+void FMonoObjectHandleTable::AdoptSlot(int32 Index)
+{
+	FMonoObjectHandle& Slot = *FindSlot(Index);
+	check(Slot.GCHandle.Load() != 0);
+
+	// a dead companion may have been replaced by a wrapper
+	if (Slot.RootIndex != INDEX_NONE)
+	{
+		CompanionRoots.Remove(Slot.RootIndex);
+		Slot.RootIndex = INDEX_NONE;
+	}
+	Slot.State = EMonoObjectHandleState::Wrapper;
+
+	if (!IsOccupied(Index))
+	{
+		MarkOccupied(Index);
+	}
+}
+
+void FMonoObjectHandleTable::RetireGCHandle(uint32_t InGCHandle)
+{
+	check(InGCHandle != 0);
+	RetiredGCHandles.Add(InGCHandle);
+}
+
+void FMonoObjectHandleTable::ReclaimRetiredGCHandles()
+{
+	check(IsInGameThread());
+	uint32_t RetiredGCHandle;
+	while (ConcurrentlyRetiredGCHandles.Dequeue(RetiredGCHandle))
+	{
+		RetiredGCHandles.Add(RetiredGCHandle);
+	}
+
+	// retired handles are no longer published, so once there are no readers nobody can be using them
+	if (RetiredGCHandles.Num() > 0 && ConcurrentReaders.GetValue() == 0)
+	{
+		for (uint32_t GCHandle : RetiredGCHandles)
+		{
+			mono_gchandle_free(GCHandle);
+		}
+		RetiredGCHandles.Reset();
+	}
+}
+
+FMonoObjectHandle& FMonoObjectHandleTable::GetAt(int32 Index)
+{
+	check(IsOccupied(Index));
+	return *FindSlot(Index);
+}
+
+const FMonoObjectHandle& FMonoObjectHandleTable::GetAt(int32 Index) const
+{
+	check(IsOccupied(Index));
+	return *FindSlot(Index);
+}
+
+UObject* FMonoObjectHandleTable::GetObjectAt(int32 Index)
+{
+	FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(Index);
+	checkSlow(ObjectItem && ObjectItem->Object);
+	return static_cast<UObject*>(ObjectItem->Object);
+}
 
+void FMonoObjectHandleTable::RemoveAt(int32 Index)
+{
+	check(IsOccupied(Index));
+
+	FMonoObjectHandle& Slot = *FindSlot(Index);
+	if (Slot.RootIndex != INDEX_NONE)
+	{
+		CompanionRoots.Remove(Slot.RootIndex);
+		Slot.RootIndex = INDEX_NONE;
+	}
+
+	// concurrent readers may still be using the GC handle
+	const uint32_t OldGCHandle = Slot.GCHandle.Exchange(0);
+	if (OldGCHandle != 0)
+	{
+		RetireGCHandle(OldGCHandle);
+	}
+	Slot.State = EMonoObjectHandleState::Reset;
+
+	Occupied[Index] = false;
+	--NumOccupied;
+}
+
+FMonoObjectHandle* FMonoObjectHandleTable::FindSlot(int32 Index) const
+{
+	check(Index >= 0 && Index < SlotsPerPage * MaxPages);
+	FMonoObjectHandle* Page = Pages[Index / SlotsPerPage].Load();
+	return nullptr != Page ? &Page[Index % SlotsPerPage] : nullptr;
+}
+
+FMonoObjectHandle& FMonoObjectHandleTable::FindOrAddSlot(int32 Index)
+{
+	checkf(Index >= 0 && Index < SlotsPerPage * MaxPages, TEXT("Object index %d is out of range for the managed object table"), Index);
+	TAtomic<FMonoObjectHandle*>& PageRef = Pages[Index / SlotsPerPage];
+	FMonoObjectHandle* Page = PageRef.Load();
+	if (nullptr == Page)
+	{
+		FMonoObjectHandle* NewPage = new FMonoObjectHandle[SlotsPerPage];
+		FMonoObjectHandle* ExpectedPage = nullptr;
+		if (PageRef.CompareExchange(ExpectedPage, NewPage))
+		{
+			Page = NewPage;
+		}
+		else
+		{
+			// another thread allocated it first
+			delete[] NewPage;
+			Page = ExpectedPage;
+		}
+	}
+	return Page[Index % SlotsPerPage];
+}
+
+void FMonoObjectHandleTable::MarkOccupied(int32 Index)
+{
+	if (Index >= Occupied.Num())
+	{
+		// grow to cover every index currently allocated in GUObjectArray, so we don't resize for each new object
+		const int32 NewNum = FMath::Max(Index + 1, GUObjectArray.GetObjectArrayNum());
+		Occupied.Add(false, NewNum - Occupied.Num());
+	}
+
+	check(!Occupied[Index]);
+	Occupied[Index] = true;
+	++NumOccupied;
+}
+
+void FMonoObjectHandleTable::FreePages()
+{
+	for (TAtomic<FMonoObjectHandle*>& PageRef : Pages)
+	{
+		delete[] PageRef.Exchange(nullptr);
+	}
+}
+
+FMonoObjectHandleTable::TIterator::TIterator(FMonoObjectHandleTable& InTable, int32 StartIndex)
+	: Table(InTable)
+	, BitIt(InTable.Occupied, StartIndex)
+{
+
+}
+
+UObject* FMonoObjectHandleTable::TIterator::Key() const
+{
+	return FMonoObjectHandleTable::GetObjectAt(BitIt.GetIndex());
+}
+
+FMonoObjectHandle& FMonoObjectHandleTable::TIterator::Value() const
+{
+	return Table.GetAt(BitIt.GetIndex());
+}
+
+void FMonoObjectHandleTable::TIterator::RemoveCurrent()
+{
+	// the bit iterator masks out bits it has already visited, so clearing the current one doesn't disturb iteration
+	Table.RemoveAt(BitIt.GetIndex());
+}
+
+FMonoObjectHandleTable::TConstIterator::TConstIterator(const FMonoObjectHandleTable& InTable, int32 StartIndex)
+	: Table(InTable)
+	, BitIt(InTable.Occupied, StartIndex)
+{
+
+}
+
+UObject* FMonoObjectHandleTable::TConstIterator::Key() const
+{
+	return FMonoObjectHandleTable::GetObjectAt(BitIt.GetIndex());
+}
+
+const FMonoObjectHandle& FMonoObjectHandleTable::TConstIterator::Value() const
+{
+	return Table.GetAt(BitIt.GetIndex());
 }
 
 FMonoObjectTable::FMonoObjectTable()
 	: Domain(nullptr)
-	, ClearNativePointerMethod(nullptr)
+	, ClearNativePointersMethod(nullptr)
+	, GCsSinceMajorCollection(0)
+	, UsedHeapSizeAfterMajorCollection(0)
 {
 	AddDelegates();
 }
@@ -143,7 +747,7 @@ FMonoObjectTable::FMonoObjectTable(FMonoObjectTable&& Other)
 
 FMonoObjectTable::~FMonoObjectTable()
 {
-	UnrealObjectToMonoObjectHandleMap.Empty();
+	UnrealObjectToMonoObjectHandleTable.Empty();
 
 	RemoveDelegates();
 }
@@ -155,65 +759,81 @@ FMonoObjectTable& FMonoObjectTable::operator=(FMonoObjectTable&& Other)
 		return *this;
 	}
 
+	// settle anything other threads published into the other table before taking over its slots
+	Other.AdoptConcurrentlyPublished();
+
 	Domain = Other.Domain;
 	Other.Domain = nullptr;
-	ClearNativePointerMethod = Other.ClearNativePointerMethod;
-	Other.ClearNativePointerMethod = nullptr;
-	// Moving a TMap which contains a move-only value fails to compile right now, Epic is looking into it
-	// Manually move over the elements
-	UnrealObjectToMonoObjectHandleMap.Empty(Other.UnrealObjectToMonoObjectHandleMap.Num());
-
-	for (auto&& Pair : Other.UnrealObjectToMonoObjectHandleMap)
-	{
-		UnrealObjectToMonoObjectHandleMap.Add(Pair.Key, MoveTemp(Pair.Value));
-	}
-	Other.UnrealObjectToMonoObjectHandleMap.Empty();
+	ClearNativePointersMethod = Other.ClearNativePointersMethod;
+	Other.ClearNativePointersMethod = nullptr;
+	check(Other.PendingClearNativePointerHandles.Num() == 0);
+	GCsSinceMajorCollection = Other.GCsSinceMajorCollection;
+	Other.GCsSinceMajorCollection = 0;
+	UsedHeapSizeAfterMajorCollection = Other.UsedHeapSizeAfterMajorCollection;
+	Other.UsedHeapSizeAfterMajorCollection = 0;
+	UnrealObjectToMonoObjectHandleTable = MoveTemp(Other.UnrealObjectToMonoObjectHandleTable);
 
 	RegisteredDelegateMap = MoveTemp(Other.RegisteredDelegateMap);
 
 	return *this;
 }
 
-void FMonoObjectTable::Initialize(FMonoDomain& InDomain, MonoMethod* InClearNativePointerMethod)
+void FMonoObjectTable::Initialize(FMonoDomain& InDomain, MonoMethod* InClearNativePointersMethod)
 {
 	Domain = &InDomain;
-	check(UnrealObjectToMonoObjectHandleMap.Num() == 0);
+	check(UnrealObjectToMonoObjectHandleTable.Num() == 0);
 
-	check(InClearNativePointerMethod);
-	ClearNativePointerMethod = InClearNativePointerMethod;
+	check(InClearNativePointersMethod);
+	ClearNativePointersMethod = InClearNativePointersMethod;
+
+	UnrealObjectToMonoObjectHandleTable.GetCompanionRoots().Initialize(InDomain.GetDomain());
 }
 
-void FMonoObjectTable::AddWrapperObject(UObject& InObject, MonoObject* WrapperObject)
+MonoObject* FMonoObjectTable::AddWrapperObject(UObject& InObject, MonoObject* WrapperObject)
 {
 	check(WrapperObject);
-	// see if it's already in the table
-	FMonoObjectHandle* Handle = UnrealObjectToMonoObjectHandleMap.Find(&InObject);
-	if (nullptr != Handle)
-	{
-		check(Handle->IsWrapper());
-		// free the existing handle (no way to set a new value unfortunately)
-		*Handle = FMonoObjectHandle(WrapperObject, false);
-	}
-	else
-	{
-		UnrealObjectToMonoObjectHandleMap.Add(&InObject, FMonoObjectHandle(WrapperObject, false));
-	}
+	// replaces an existing handle whose wrapper has been collected
+	return UnrealObjectToMonoObjectHandleTable.PublishWrapperObject(InObject, WrapperObject);
 }
 
 void FMonoObjectTable::AddCompanionObject(UObject& InObject, MonoObject* CompanionObject)
 {
 	check(CompanionObject);
-	//if this fails, check for subobjects/components in managed CDO creation that are accessing their
-	// parent (and creating a wrapper, since the parent's companion object isn't set yet)
-	check(nullptr == UnrealObjectToMonoObjectHandleMap.Find(&InObject));
+	AdoptConcurrentlyPublished();
+
+	FMonoObjectHandle* ExistingHandle = UnrealObjectToMonoObjectHandleTable.Find(InObject);
+	if (nullptr != ExistingHandle)
+	{
+		//if this fails, check for subobjects/components in managed CDO creation that are accessing their
+		// parent (and creating a wrapper, since the parent's companion object isn't set yet)
+		check(ExistingHandle->IsWrapper());
+
+		// a wrapper was published before the companion was set, possibly from another thread. The companion replaces it,
+		// so clear the wrapper's native pointer now since nothing else will
+		QueueClearNativePointer(*ExistingHandle);
+		UnrealObjectToMonoObjectHandleTable.Remove(InObject);
+		FlushClearNativePointers();
+	}
+
+	// companions have a strong ref to their managed object, through a slot in the root pool
+	const int32 RootIndex = UnrealObjectToMonoObjectHandleTable.GetCompanionRoots().Add(CompanionObject);
+	uint32_t ReplacedGCHandle = 0;
+	UnrealObjectToMonoObjectHandleTable.Add(InObject, FMonoObjectHandle(CompanionObject, true, RootIndex), ReplacedGCHandle);
 
-	// companions currently have a strong ref to their  managed object
-	UnrealObjectToMonoObjectHandleMap.Add(&InObject, FMonoObjectHandle(CompanionObject, true));
+	if (ReplacedGCHandle != 0)
+	{
+		// another thread raced us with a wrapper, the companion wins. Nothing will clear the wrapper's native pointer later, so do it now
+		PendingClearNativePointerHandles.Add(ReplacedGCHandle);
+		FlushClearNativePointers();
+	}
 }
 
-MonoObject* FMonoObjectTable::GetManagedObject(UObject& InObject) const
+MonoObject* FMonoObjectTable::GetManagedObject(UObject& InObject)
 {
-	const FMonoObjectHandle* Handle = UnrealObjectToMonoObjectHandleMap.Find(&InObject);
+	check(IsInGameThread());
+	AdoptConcurrentlyPublished();
+
+	const FMonoObjectHandle* Handle = UnrealObjectToMonoObjectHandleTable.Find(InObject);
 
 	if (nullptr == Handle)
 	{
@@ -228,15 +848,22 @@ MonoObject* FMonoObjectTable::GetManagedObject(UObject& InObject) const
 	}
 }
 
+MonoObject* FMonoObjectTable::GetManagedObjectConcurrent(UObject& InObject) const
+{
+	return UnrealObjectToMonoObjectHandleTable.GetManagedObjectConcurrent(InObject);
+}
+
 void FMonoObjectTable::RemoveObject(UObject& InObject)
 {
-	FMonoObjectHandle* Handle = UnrealObjectToMonoObjectHandleMap.Find(&InObject);
+	AdoptConcurrentlyPublished();
+	FMonoObjectHandle* Handle = UnrealObjectToMonoObjectHandleTable.Find(InObject);
 
 	// it's ok for this to be not in the table, it may have been removed during a gc
 	if (nullptr != Handle)
 	{
-		ClearNativePointer(Handle->GetTargetObject());
-		UnrealObjectToMonoObjectHandleMap.Remove(&InObject);
+		QueueClearNativePointer(*Handle);
+		UnrealObjectToMonoObjectHandleTable.Remove(InObject);
+		FlushClearNativePointers();
 	}
 
 	UnregisterObjectDelegates(InObject);
@@ -270,7 +897,8 @@ void FMonoObjectTable::UnregisterAllObjectDelegates()
 void FMonoObjectTable::ResetForReload()
 {
 	// toss wrappers before saving state, but leave companions. Wrappers will be reconstructed on demand
-	for (TMap<UObject*, FMonoObjectHandle>::TIterator It(UnrealObjectToMonoObjectHandleMap); It; ++It)
+	AdoptConcurrentlyPublished();
+	for (FMonoObjectHandleTable::TIterator It(UnrealObjectToMonoObjectHandleTable); It; ++It)
 	{
 		FMonoObjectHandle& Handle = It.Value();
 		// toss wrapper objects, preserve companions
@@ -287,7 +915,7 @@ void FMonoObjectTable::ResetForReload()
 
 void FMonoObjectTable::GetObjectsWithCompanions(TArray<UObject*>& OutObjects) const
 {
-	for (TMap<UObject*, FMonoObjectHandle>::TConstIterator It(UnrealObjectToMonoObjectHandleMap); It; ++It)
+	for (FMonoObjectHandleTable::TConstIterator It(UnrealObjectToMonoObjectHandleTable); It; ++It)
 	{
 		const FMonoObjectHandle& Handle = It.Value();
 		// only companions should be left
@@ -303,15 +931,47 @@ void FMonoObjectTable::GetObjectsWithCompanions(TArray<UObject*>& OutObjects) co
 
 #endif // MONO_WITH_HOT_RELOADING
 
-void FMonoObjectTable::ClearNativePointer(MonoObject* Target) const
+void FMonoObjectTable::QueueClearNativePointer(FMonoObjectHandle& InHandle)
+{
+	// keep the GC handle rather than the target, objects may move if the managed heap is collected before we flush
+	PendingClearNativePointerHandles.Add(InHandle.ReleaseGCHandle());
+}
+
+void FMonoObjectTable::FlushClearNativePointers()
 {
-	if (nullptr != Target)
+	const int32 Count = PendingClearNativePointerHandles.Num();
+	if (Count == 0)
+	{
+		return;
+	}
+
+	check(Domain);
+	check(ClearNativePointersMethod);
+
+	// clear the native pointers on the mono objects, they have been destroyed
+	MonoArray* HandleArray = mono_array_new(Domain->GetDomain(), mono_get_intptr_class(), Count);
+	for (int32 i = 0; i < Count; ++i)
 	{
-		check(Domain);
-		check(ClearNativePointerMethod);
-		// clear the native point on the mono object, it has been destroyed
-		Mono::Invoke<void>(*Domain, ClearNativePointerMethod, Target);
+		mono_array_set(HandleArray, intptr_t, i, (intptr_t)PendingClearNativePointerHandles[i]);
 	}
+
+	void* Arguments[] = { HandleArray, const_cast<int32*>(&Count) };
+	bool bThrewException = false;
+	Mono::Invoke(bThrewException, Domain->GetExceptionBehavior(), Domain->GetDomain(), ClearNativePointersMethod, nullptr, Arguments);
+
+	// the handles were unpublished when queued, but concurrent readers may still hold them
+	for (uint32_t GCHandle : PendingClearNativePointerHandles)
+	{
+		UnrealObjectToMonoObjectHandleTable.RetireGCHandle(GCHandle);
+	}
+	PendingClearNativePointerHandles.Reset();
+	UnrealObjectToMonoObjectHandleTable.ReclaimRetiredGCHandles();
+}
+
+void FMonoObjectTable::AdoptConcurrentlyPublished()
+{
+	UnrealObjectToMonoObjectHandleTable.AdoptConcurrentlyPublished(PendingClearNativePointerHandles);
+	FlushClearNativePointers();
 }
 
 void FMonoObjectTable::OnTraceExternalRootsForReachabilityAnalysis(FGarbageCollectionTracer& Tracer, EObjectFlags KeepFlags, bool bForceSingleThreaded)
@@ -319,65 +979,103 @@ void FMonoObjectTable::OnTraceExternalRootsForReachabilityAnalysis(FGarbageColle
 	FGCArrayStruct* ArrayStruct = FGCArrayPool::Get().GetArrayStructFromPool();
 	TArray<UObject*>& ObjectsToSerialize = ArrayStruct->ObjectsToSerialize;
 
-	ObjectsToSerialize.Empty(UnrealObjectToMonoObjectHandleMap.Num());
+	ObjectsToSerialize.Empty(UnrealObjectToMonoObjectHandleTable.Num());
+
+	const uint32 GCHandleAllocationsAtStart = GMonoGCHandleAllocations.GetValue();
+
+	// pick up wrappers published by other threads so they are traced, and free handles nobody can be reading any more
+	// other threads publish under a GC scope guard, so nothing can be published between here and the end of the sweep
+	AdoptConcurrentlyPublished();
+	UnrealObjectToMonoObjectHandleTable.ReclaimRetiredGCHandles();
 
 	double TraceExternalRootsTime = 0.0;
 	{
 		SCOPE_SECONDS_COUNTER(TraceExternalRootsTime);
 
-		bool bAnyPossiblyDead = false;
+		FMonoObjectHandleTable& Table = UnrealObjectToMonoObjectHandleTable;
+		const int32 MaxIndex = Table.GetMaxIndex();
+		TArray<FTraceSweepChunk> Chunks;
+		Chunks.SetNum(FMath::DivideAndRoundUp(MaxIndex, TraceSweepChunkSize));
 
 		// this is called after UE4's gc has done a full reachability analysis of its graph.
 		// process our object table. Any companions which are reachable must be roots in GC (by default they have strong references)
 		// Any companions which are unreachable should be converted to weak refs
-		for (TMap<UObject*, FMonoObjectHandle>::TIterator It(UnrealObjectToMonoObjectHandleMap); It; ++It)
+		// Classification only reads object flags, so it is split across workers. Anything that calls into mono happens in the serial fix-up below.
+		ParallelFor(Chunks.Num(), [&Table, &Chunks, MaxIndex](int32 ChunkIndex)
 		{
-			UObject* ReferencedObject = It.Key();
-			FMonoObjectHandle& Handle = It.Value();
+			FTraceSweepChunk& Chunk = Chunks[ChunkIndex];
+			const int32 EndIndex = FMath::Min((ChunkIndex + 1) * TraceSweepChunkSize, MaxIndex);
+			for (FMonoObjectHandleTable::TConstIterator It(Table, ChunkIndex * TraceSweepChunkSize); It && It.GetIndex() < EndIndex; ++It)
+			{
+				UObject* ReferencedObject = It.Key();
+				if (ReferencedObject->IsPendingKill())
+				{
+					Chunk.DeadIndices.Add(It.GetIndex());
+				}
+				else if (It.Value().IsCompanion() && ReferencedObject->IsUnreachable())
+				{
+					Chunk.CompanionIndices.Add(It.GetIndex());
+				}
+			}
+		}, bForceSingleThreaded);
 
+		bool bAnyPossiblyDead = false;
 
-			if (ReferencedObject->IsPendingKill())
+		for (FTraceSweepChunk& Chunk : Chunks)
+		{
+			for (int32 Index : Chunk.DeadIndices)
 			{
 				// pending kill objects have been forcibly killed by unreal's gc
 				// so we always kill them
 				// clear the native pointer on the object
-				ClearNativePointer(Handle.GetTargetObject());
+				QueueClearNativePointer(Table.GetAt(Index));
 				// remove any registered delegates
-				UnregisterObjectDelegates(*ReferencedObject);
-				It.RemoveCurrent();
+				UnregisterObjectDelegates(*FMonoObjectHandleTable::GetObjectAt(Index));
+				Table.RemoveAt(Index);
 			}
-			else if (Handle.IsCompanion())
+			for (int32 Index : Chunk.CompanionIndices)
 			{
-				// these should have been dealt with in AddReferencedObjects
-				if (ReferencedObject->IsUnreachable ())
-				{
-					Handle.MarkCompanionAsPossiblyDead();
-					bAnyPossiblyDead = true;
-				}
+				Table.GetAt(Index).MarkCompanionAsPossiblyDead(Table.GetCompanionRoots());
+				bAnyPossiblyDead = true;
 			}
+			Chunk.DeadIndices.Reset();
+			Chunk.CompanionIndices.Reset();
 		}
 
-		// run the full mono GC
+		// release the killed objects before collecting, so they can be reclaimed by this GC
+		FlushClearNativePointers();
+
+		// run the mono GC
+		const int32 Generation = SelectManagedGCGeneration(bAnyPossiblyDead);
 		double MonoGCTime = 0.0;
 		{
 			SCOPE_SECONDS_COUNTER(MonoGCTime)
-				// not using a time limit, force a full mono GC
-				mono_gc_collect(mono_gc_max_generation());
+				// not using a time limit
+				mono_gc_collect(Generation);
+		}
+		if (Generation == mono_gc_max_generation())
+		{
+			GCsSinceMajorCollection = 0;
+			UsedHeapSizeAfterMajorCollection = mono_gc_get_used_size();
+		}
+		else
+		{
+			++GCsSinceMajorCollection;
 		}
 		if (MonoGCTime > 0.0)
 		{
-			UE_LOG(LogMono, Log, TEXT("Managed garbage collection took %g ms"), MonoGCTime*1000.0);
+			UE_LOG(LogMono, Log, TEXT("Managed garbage collection (generation %d) took %g ms"), Generation, MonoGCTime*1000.0);
 		}
 
 		// now mono has run its gc, check if any of our companions or wrappers died
-		for (TMap<UObject*, FMonoObjectHandle>::TIterator It(UnrealObjectToMonoObjectHandleMap); It; ++It)
+		// This reads GC handle targets, so it stays on the game thread rather than on task graph threads which aren't attached to mono
+		for (FMonoObjectHandleTable::TIterator It(Table); It; ++It)
 		{
 			FMonoObjectHandle& Handle = It.Value();
 			UObject* ReferencedObject = It.Key();
 			checkSlow(!ReferencedObject->IsPendingKill());
 
-			MonoObject* Target = Handle.GetTargetObject();
-			if (nullptr == Target)
+			if (nullptr == Handle.GetTargetObject())
 			{
 				// this is dead, remove it
 				if (Handle.IsCompanion())
@@ -389,9 +1087,10 @@ void FMonoObjectTable::OnTraceExternalRootsForReachabilityAnalysis(FGarbageColle
 			else
 			{
 				// do not remove it, add it to objects to serialize
-				if (Handle.IsCompanion())
+				// companions only need to switch back to strong handles if any were marked as possibly dead
+				if (bAnyPossiblyDead && Handle.IsCompanion())
 				{
-					Handle.MarkCompanionAsAlive();
+					Handle.MarkCompanionAsAlive(Table.GetCompanionRoots());
 				}
 				ObjectsToSerialize.Add(ReferencedObject);
 			}
@@ -412,10 +1111,44 @@ void FMonoObjectTable::OnTraceExternalRootsForReachabilityAnalysis(FGarbageColle
 
 	FGCArrayPool::Get().ReturnToPool(ArrayStruct);
 
+	const uint32 GCHandleAllocations = GMonoGCHandleAllocations.GetValue() - GCHandleAllocationsAtStart;
+	SET_DWORD_STAT(STAT_MonoGCHandleAllocationsPerGC, GCHandleAllocations);
+
 	if (TraceExternalRootsTime > 0.0)
 	{
-		UE_LOG(LogMono, Log, TEXT("Mono TraceExternalRootsForReachabilityAnalysis took %g ms"), TraceExternalRootsTime*1000.0);
+		UE_LOG(LogMono, Log, TEXT("Mono TraceExternalRootsForReachabilityAnalysis took %g ms, %u GC handle allocations"), TraceExternalRootsTime*1000.0, GCHandleAllocations);
+	}
+}
+
+int32 FMonoObjectTable::SelectManagedGCGeneration(bool bAnyPossiblyDead) const
+{
+	const int32 MaxGeneration = mono_gc_max_generation();
+
+	// A companion which lost its unreal references is only held by a weak handle now, and may live in any generation.
+	// We have to do a full collection to find out whether managed code still references it.
+	if (!GMonoIncrementalGC || bAnyPossiblyDead)
+	{
+		return MaxGeneration;
+	}
+
+	if (GMonoMajorGCInterval > 0 && GCsSinceMajorCollection + 1 >= GMonoMajorGCInterval)
+	{
+		return MaxGeneration;
 	}
+
+	if (GMonoMajorGCHeapGrowthPercent > 0.0f)
+	{
+		const int64 UsedHeapSize = mono_gc_get_used_size();
+		const int64 HeapGrowthLimit = UsedHeapSizeAfterMajorCollection + (int64)(UsedHeapSizeAfterMajorCollection * (GMonoMajorGCHeapGrowthPercent / 100.0f));
+		if (UsedHeapSize > HeapGrowthLimit)
+		{
+			return MaxGeneration;
+		}
+	}
+
+	// Only wrappers can die from a nursery collection. Their weak handles are cleared if they were unreferenced, 
+	// older unreferenced wrappers will be picked up by the next major collection
+	return 0;
 }
 
 void FMonoObjectTable::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
@@ -428,18 +1161,29 @@ void FMonoObjectTable::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool
 	check(InWorld);
 	UPackage* Outermost = InWorld->GetOutermost();
 	// release objects that are in this world
-	for (TMap<UObject*, FMonoObjectHandle>::TIterator It(UnrealObjectToMonoObjectHandleMap); It; ++It)
+	FMonoObjectHandleTable& Table = UnrealObjectToMonoObjectHandleTable;
+	AdoptConcurrentlyPublished();
+
+	// the engine's outer hash already buckets objects by outer and moves them when they are renamed,
+	// so we only visit the objects in this world rather than every entry in the table
+	TArray<int32> Indices;
+	ForEachObjectWithOuter(Outermost, [&Table, &Indices](UObject* Object)
 	{
-		UObject* Object = It.Key();		
-		if (Object->IsIn(Outermost))
+		const int32 Index = GUObjectArray.ObjectToIndex(Object);
+		if (Table.IsOccupied(Index))
 		{
-			FMonoObjectHandle& Handle = It.Value();
-			// clear out the managed object's reference to this object
-			ClearNativePointer(Handle.GetTargetObject());
-			UnregisterObjectDelegates(*Object);
-			It.RemoveCurrent();
+			Indices.Add(Index);
 		}
+	}, true);
+
+	for (int32 Index : Indices)
+	{
+		// clear out the managed object's reference to this object
+		QueueClearNativePointer(Table.GetAt(Index));
+		UnregisterObjectDelegates(*FMonoObjectHandleTable::GetObjectAt(Index));
+		Table.RemoveAt(Index);
 	}
+	FlushClearNativePointers();
 }
 
 void FMonoObjectTable::AddDelegates()
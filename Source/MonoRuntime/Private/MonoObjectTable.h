@@ -6,12 +6,18 @@
 #include "CoreTypes.h"
 #include "MonoRuntimePrivate.h"
 #include "UObject/Object.h"
+#include "UObject/UObjectArray.h"
+#include "Containers/BitArray.h"
+#include "Containers/Queue.h"
+#include "Templates/Atomic.h"
+#include "HAL/ThreadSafeCounter.h"
 #include <mono/metadata/object.h>
 
 class FGarbageCollectionTracer;
 
 class FMonoDelegateHandle;
 class FMonoDomain;
+class FMonoCompanionRootPool;
 
 enum EMonoObjectHandleState : uint8
 {
@@ -29,7 +35,8 @@ struct FMonoObjectHandle
 {
 	FMonoObjectHandle();
 
-	FMonoObjectHandle(MonoObject* TargetObject, bool InIsCompanion);
+	// companions pass the slot which roots them in the companion root pool
+	FMonoObjectHandle(MonoObject* TargetObject, bool InIsCompanion, int32 InRootIndex = INDEX_NONE);
 	FMonoObjectHandle(FMonoObjectHandle&& Other);
 	~FMonoObjectHandle();
 
@@ -40,19 +47,185 @@ struct FMonoObjectHandle
 	bool IsWrapper() const;
 	bool IsCompanion() const;
 	
-	void MarkCompanionAsPossiblyDead();
-	void MarkCompanionAsAlive();
+	void MarkCompanionAsPossiblyDead(FMonoCompanionRootPool& CompanionRoots);
+	void MarkCompanionAsAlive(FMonoCompanionRootPool& CompanionRoots);
+
+	int32 GetRootIndex() const { return RootIndex; }
+
+	// resets the handle, handing ownership of the underlying GC handle to the caller. The root slot is left for the owning table to free
+	uint32_t ReleaseGCHandle();
 
 	FMonoObjectHandle(const FMonoObjectHandle&) = delete;
 	FMonoObjectHandle& operator=(const FMonoObjectHandle&) = delete;
 
 private:
+	friend class FMonoObjectHandleTable;
+
 	void Reset();
 
-	uint32_t GCHandle;
+	// weak handle, held for the lifetime of the entry. Companions are kept alive through their slot in the companion root pool
+	// Published and read atomically so the handle table can be read from worker threads, everything else is game thread only
+	TAtomic<uint32_t> GCHandle;
+	int32 RootIndex;
 	EMonoObjectHandleState State;
 };
 
+// Roots companions which are alive by storing them in a managed object[] that is held by a single strong GC handle.
+// Switching a companion between alive and possibly dead is a store into its slot rather than swapping GC handles.
+class FMonoCompanionRootPool
+{
+public:
+	FMonoCompanionRootPool();
+	FMonoCompanionRootPool(FMonoCompanionRootPool&& Other);
+	~FMonoCompanionRootPool();
+
+	FMonoCompanionRootPool& operator=(FMonoCompanionRootPool&& Other);
+
+	void Initialize(MonoDomain* InDomain);
+
+	int32 Add(MonoObject* Target);
+	void Remove(int32 SlotIndex);
+	void Set(int32 SlotIndex, MonoObject* Target);
+
+	void Empty();
+
+	FMonoCompanionRootPool(const FMonoCompanionRootPool&) = delete;
+	FMonoCompanionRootPool& operator=(const FMonoCompanionRootPool&) = delete;
+
+private:
+	MonoArray* GetArray() const;
+	void Grow();
+
+	MonoDomain* Domain;
+	uint32_t ArrayGCHandle;
+	int32 Capacity;
+	// slots below this index have been handed out at least once
+	int32 NumAllocated;
+	TArray<int32> FreeSlots;
+};
+
+// Dense table of object handles, addressed by the UObject's index in GUObjectArray.
+// Occupancy is tracked in a separate bit array so sweeps only visit slots which are in use.
+// Slots live in pages which never move, so wrappers can be looked up and published from any thread without locks:
+// a slot's GC handle is published with a CAS, and other threads' publications are adopted by the game thread before it walks the table.
+// Other threads must hold off unreal's GC while they publish, so every publication is adopted before the GC's trace sweeps the table.
+// GC handles removed from the table are retired rather than freed, and only freed once no concurrent readers are active.
+class FMonoObjectHandleTable
+{
+public:
+	FMonoObjectHandleTable();
+	FMonoObjectHandleTable(FMonoObjectHandleTable&& Other);
+	~FMonoObjectHandleTable();
+
+	FMonoObjectHandleTable& operator=(FMonoObjectHandleTable&& Other);
+
+	FMonoObjectHandle* Find(const UObject& InObject);
+	const FMonoObjectHandle* Find(const UObject& InObject) const;
+
+	// a wrapper published by another thread since the caller last adopted is replaced, its GC handle is handed to the caller in OutReplacedGCHandle
+	FMonoObjectHandle& Add(const UObject& InObject, FMonoObjectHandle&& InHandle, uint32_t& OutReplacedGCHandle);
+	void Remove(const UObject& InObject);
+
+	int32 Num() const { return NumOccupied; }
+	void Empty();
+
+	// can be called from any thread
+	MonoObject* GetManagedObjectConcurrent(const UObject& InObject) const;
+	// publishes a wrapper for the object, unless a live managed object was published first. Returns whichever is in the table.
+	// Can be called from any thread, publications from other threads are adopted by the next call to AdoptConcurrentlyPublished
+	MonoObject* PublishWrapperObject(const UObject& InObject, MonoObject* WrapperObject);
+
+	// game thread only
+	// Publications for objects whose index has since been reused are unpublished, their GC handles are handed to the caller in OutStaleGCHandles
+	void AdoptConcurrentlyPublished(TArray<uint32_t>& OutStaleGCHandles);
+	void RetireGCHandle(uint32_t InGCHandle);
+	void ReclaimRetiredGCHandles();
+
+	// one past the highest slot index that may be occupied, used to partition sweeps
+	int32 GetMaxIndex() const { return Occupied.Num(); }
+
+	FMonoCompanionRootPool& GetCompanionRoots() { return CompanionRoots; }
+
+	bool IsOccupied(int32 Index) const { return Index < Occupied.Num() && Occupied[Index]; }
+	FMonoObjectHandle& GetAt(int32 Index);
+	const FMonoObjectHandle& GetAt(int32 Index) const;
+	static UObject* GetObjectAt(int32 Index);
+	void RemoveAt(int32 Index);
+
+	// iterates over occupied slots, mirrors the TMap iterator interface so it's safe to remove the current element
+	class TIterator
+	{
+	public:
+		explicit TIterator(FMonoObjectHandleTable& InTable, int32 StartIndex = 0);
+
+		int32 GetIndex() const { return BitIt.GetIndex(); }
+		UObject* Key() const;
+		FMonoObjectHandle& Value() const;
+		void RemoveCurrent();
+
+		FORCEINLINE explicit operator bool() const { return !!BitIt; }
+		FORCEINLINE TIterator& operator++() { ++BitIt; return *this; }
+
+	private:
+		FMonoObjectHandleTable& Table;
+		TConstSetBitIterator<> BitIt;
+	};
+
+	class TConstIterator
+	{
+	public:
+		explicit TConstIterator(const FMonoObjectHandleTable& InTable, int32 StartIndex = 0);
+
+		int32 GetIndex() const { return BitIt.GetIndex(); }
+		UObject* Key() const;
+		const FMonoObjectHandle& Value() const;
+
+		FORCEINLINE explicit operator bool() const { return !!BitIt; }
+		FORCEINLINE TConstIterator& operator++() { ++BitIt; return *this; }
+
+	private:
+		const FMonoObjectHandleTable& Table;
+		TConstSetBitIterator<> BitIt;
+	};
+
+	FMonoObjectHandleTable(const FMonoObjectHandleTable&) = delete;
+	FMonoObjectHandleTable& operator=(const FMonoObjectHandleTable&) = delete;
+
+private:
+	enum
+	{
+		SlotsPerPage = 16 * 1024,
+		MaxPages = 2 * 1024
+	};
+
+	FMonoObjectHandle* FindSlot(int32 Index) const;
+	FMonoObjectHandle& FindOrAddSlot(int32 Index);
+	void AdoptSlot(int32 Index);
+
+	struct FConcurrentPublication
+	{
+		int32 Index;
+		// serial number of the object the wrapper was published for, so a reused index isn't adopted for the wrong object
+		int32 SerialNumber;
+		uint32_t GCHandle;
+	};
+	void MarkOccupied(int32 Index);
+	void FreePages();
+
+	TAtomic<FMonoObjectHandle*> Pages[MaxPages];
+	TBitArray<> Occupied;
+	int32 NumOccupied;
+	FMonoCompanionRootPool CompanionRoots;
+
+	// GC handles published off the game thread, waiting to be adopted
+	TQueue<FConcurrentPublication, EQueueMode::Mpsc> ConcurrentlyPublishedSlots;
+	// GC handles replaced off the game thread, waiting to be retired
+	TQueue<uint32_t, EQueueMode::Mpsc> ConcurrentlyRetiredGCHandles;
+	// GC handles which have been unpublished, but may still be in use by a concurrent reader
+	TArray<uint32_t> RetiredGCHandles;
+	mutable FThreadSafeCounter ConcurrentReaders;
+};
+
 
 class FMonoObjectTable
 {
@@ -64,12 +237,15 @@ public:
 	// move assignment
 	FMonoObjectTable& operator=(FMonoObjectTable&& Other);
 
-	void Initialize(FMonoDomain& InDomain, MonoMethod* InClearNativePointerMethod);
+	void Initialize(FMonoDomain& InDomain, MonoMethod* InClearNativePointersMethod);
 
-	void AddWrapperObject(UObject& InObject, MonoObject* WrapperObject);
+	// returns the managed object in the table, which may not be WrapperObject if another thread published a wrapper first
+	MonoObject* AddWrapperObject(UObject& InObject, MonoObject* WrapperObject);
 	void AddCompanionObject(UObject& InObject, MonoObject* CompanionObject);
 
-	MonoObject* GetManagedObject(UObject& InObject) const;
+	MonoObject* GetManagedObject(UObject& InObject);
+	// lock free lookup which can be called from any thread
+	MonoObject* GetManagedObjectConcurrent(UObject& InObject) const;
 	void RemoveObject(UObject& InObject);
 
 	void RegisterObjectDelegate(UObject& InObject, FMonoDelegateHandle& InDelegateHandle);
@@ -89,22 +265,38 @@ public:
 
 private:
 	void ResetHandle(FMonoObjectHandle& InHandle) const;
-	void ClearNativePointer(MonoObject* InObject) const;
+	// queue the handle's managed object to have its native pointer cleared, takes ownership of the GC handle
+	void QueueClearNativePointer(FMonoObjectHandle& InHandle);
+	// clear native pointers on all queued managed objects with a single managed call
+	void FlushClearNativePointers();
+	// adopt wrappers published by other threads, clearing the native pointers of any which were published for a destroyed object
+	void AdoptConcurrentlyPublished();
 
 	void OnTraceExternalRootsForReachabilityAnalysis(FGarbageCollectionTracer& Tracer, EObjectFlags KeepFlags, bool bForceSingleThreaded);
 
+	// picks the managed generation to collect during an unreal GC, based on the MonoRuntime.GC.* console variables
+	int32 SelectManagedGCGeneration(bool bAnyPossiblyDead) const;
+
 	void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
 
 	void AddDelegates();
 	void RemoveDelegates();
 
-	TMap<UObject*, FMonoObjectHandle> UnrealObjectToMonoObjectHandleMap;
+	FMonoObjectHandleTable UnrealObjectToMonoObjectHandleTable;
 	TMap<UObject*, TArray<TSharedRef<FMonoDelegateHandle>>> RegisteredDelegateMap;
 
 	FMonoDomain* Domain;
-	MonoMethod* ClearNativePointerMethod;
+	MonoMethod* ClearNativePointersMethod;
+
+	// GC handles queued for ClearNativePointers, owned by the table until flushed
+	TArray<uint32_t> PendingClearNativePointerHandles;
 
 	FDelegateHandle OnWorldCleanupHandle;
 	FDelegateHandle TraceRootsHandle;
 
+	// number of unreal GCs since we last ran a full managed collection
+	int32 GCsSinceMajorCollection;
+	// managed heap usage measured right after the last full managed collection
+	int64 UsedHeapSizeAfterMajorCollection;
+
 };
\ No newline at end of file
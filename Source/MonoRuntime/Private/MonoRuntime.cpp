@@ -12,6 +12,8 @@
 #include "Misc/App.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
 #include "Engine/Engine.h"
 
 #include <mono/jit/jit.h>
@@ -65,6 +67,10 @@ private:
 
 	inline FString GetAssemblyDirectory(const FString &RootDirectory) { return FMonoMainDomain::GetConfigurationSpecificSubdirectory(FPaths::Combine(*RootDirectory, TEXT("Binaries"))); }
 
+	// reports time to first tick, which is where JIT vs AOT shows up at startup
+	void OnFirstFrame();
+	FDelegateHandle FirstFrameHandle;
+
 #if WITH_EDITOR
 	FString PluginDotNETDirectory;
 #endif // WITH_EDITOR
@@ -172,6 +178,27 @@ void FMonoRuntime::StartupModule()
 	// Initialization of Mono UObject classes is deferred so that MonoBindings is valid when managed ctors are called.
 	// Otherwise, class default objects wouldn't be able to create subobjects.
 	MonoBindings->InitializeMonoClasses();
+
+	FirstFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FMonoRuntime::OnFirstFrame);
+}
+
+void FMonoRuntime::OnFirstFrame()
+{
+	FCoreDelegates::OnBeginFrame.Remove(FirstFrameHandle);
+	FirstFrameHandle.Reset();
+
+	const double TimeToFirstTick = FPlatformTime::Seconds() - GStartTime;
+
+	// -MonoColdStartBenchmark is used by the cold start perf test, which launches the engine and parses this line
+	if (FParse::Param(FCommandLine::Get(), TEXT("MonoColdStartBenchmark")))
+	{
+		UE_LOG(LogMono, Display, TEXT("MonoColdStart: TimeToFirstTick=%.3f AotImagesFound=%d ForceJIT=%d"), TimeToFirstTick, FMonoMainDomain::GetNumAotImagesFound(), FMonoMainDomain::IsJITForced() ? 1 : 0);
+		FPlatformMisc::RequestExit(false);
+	}
+	else
+	{
+		UE_LOG(LogMono, Log, TEXT("Time to first tick %.3f s, AOT images found for %d assemblies%s."), TimeToFirstTick, FMonoMainDomain::GetNumAotImagesFound(), FMonoMainDomain::IsJITForced() ? TEXT(" (JIT forced)") : TEXT(""));
+	}
 }
 
 
@@ -179,6 +206,12 @@ void FMonoRuntime::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	if (FirstFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnBeginFrame.Remove(FirstFrameHandle);
+		FirstFrameHandle.Reset();
+	}
+
 	MonoBindings.Reset();
 	MonoMainDomain.Reset();
 
@@ -5,9 +5,12 @@
 
 #include "Logging/LogMacros.h"
 #include "Internationalization/Internationalization.h"
+#include "Stats/Stats.h"
 
 MONORUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogMono, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("Mono"), STATGROUP_Mono, STATCAT_Advanced);
+
 // define this to 1 to support hot reloading
 #define MONO_WITH_HOT_RELOADING WITH_EDITOR
 
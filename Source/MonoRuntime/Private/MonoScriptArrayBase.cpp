@@ -40,3 +40,33 @@ MONO_PINVOKE_FUNCTION(void) ScriptArrayBase_RemoveFromArray(UProperty* ArrayProp
 	FScriptArrayHelper Helper(CastChecked<UArrayProperty>(ArrayProperty), ScriptArray);
 	Helper.RemoveValues(index);
 }
+
+// UnrealEngine.Runtime.UnrealArrayOwned pinvokes
+// These work on arrays handed over by UnrealObject_InvokeFunction. Inserting, removing and emptying treat elements as raw bytes, which is only
+// done for blittable elements, but freeing destroys the elements through the array property since any array may be freed this way.
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Insert(FScriptArray* ScriptArray, int Index, int Count, int ElementSize)
+{
+	check(ScriptArray);
+	ScriptArray->Insert(Index, Count, ElementSize);
+}
+
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Remove(FScriptArray* ScriptArray, int Index, int Count, int ElementSize)
+{
+	check(ScriptArray);
+	ScriptArray->Remove(Index, Count, ElementSize);
+}
+
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Free(UProperty* ArrayProperty, FScriptArray* ScriptArray)
+{
+	check(ArrayProperty);
+	check(ScriptArray);
+	FScriptArrayHelper Helper(CastChecked<UArrayProperty>(ArrayProperty), ScriptArray);
+	Helper.EmptyValues();
+}
+
+// Blittable elements have nothing to destroy, so this doesn't need the array property and is safe to call from the finalizer thread
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Empty(FScriptArray* ScriptArray, int ElementSize)
+{
+	check(ScriptArray);
+	ScriptArray->Empty(0, ElementSize);
+}
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#include "MonoScriptPackageClassIndex.h"
+#include "MonoRuntimePrivate.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/Package.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Script Package Class Index"), STAT_MonoBuildScriptPackageClassIndex, STATGROUP_Mono);
+
+FMonoScriptPackageClassIndex::FMonoScriptPackageClassIndex()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MonoBuildScriptPackageClassIndex);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+
+	IndexedObjects.Init(false, GUObjectArray.GetObjectArrayCapacity());
+
+	// listen first, under the lock, so a class created during the walk is either seen by it or added once it's done
+	GUObjectArray.AddUObjectCreateListener(this);
+	GUObjectArray.AddUObjectDeleteListener(this);
+
+	for (TObjectIterator<UClass> ClassIt(RF_ClassDefaultObject, false); ClassIt; ++ClassIt)
+	{
+		AddClass(*ClassIt);
+	}
+
+	UE_LOG(LogMono, Log, TEXT("Indexed %d classes in %d packages in %.2f ms"), ClassPackages.Num(), ClassesByPackage.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+FMonoScriptPackageClassIndex::~FMonoScriptPackageClassIndex()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	GUObjectArray.RemoveUObjectDeleteListener(this);
+}
+
+void FMonoScriptPackageClassIndex::GetClassesInPackage(FName PackageName, TArray<UClass*>& OutClasses) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (const TArray<UClass*>* Classes = ClassesByPackage.Find(PackageName))
+	{
+		for (UClass* Class : *Classes)
+		{
+			if (IsStillInPackage(*Class, PackageName))
+			{
+				OutClasses.Add(Class);
+			}
+		}
+	}
+}
+
+void FMonoScriptPackageClassIndex::GetPackageNames(TSet<FName>& OutPackageNames) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (const auto& PackageClasses : ClassesByPackage)
+	{
+		for (const UClass* Class : PackageClasses.Value)
+		{
+			if (IsStillInPackage(*Class, PackageClasses.Key))
+			{
+				OutPackageNames.Add(PackageClasses.Key);
+				break;
+			}
+		}
+	}
+}
+
+void FMonoScriptPackageClassIndex::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// this runs for every object created, so reject non-classes with the cast flags (what IsA<UClass> boils down to for Cast) before anything else
+	// by the time an object is added to the array its class, outer and flags are set
+	if (!Object->GetClass()->HasAnyCastFlag(CASTCLASS_UClass) || (Object->GetFlags() & RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	AddClass(static_cast<UClass*>(const_cast<UObjectBase*>(Object)));
+}
+
+void FMonoScriptPackageClassIndex::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	// this runs for every object destroyed, including every GC purge, so skip anything we didn't index before taking the lock.
+	// The dying object's class may already have been destroyed by the same purge, so its cast flags can't be used here.
+	if (!IndexedObjects[Index])
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	IndexedObjects[Index] = false;
+
+	FName PackageName;
+	if (ClassPackages.RemoveAndCopyValue(Object, PackageName))
+	{
+		TArray<UClass*>& Classes = ClassesByPackage.FindChecked(PackageName);
+		Classes.RemoveSingleSwap(static_cast<UClass*>(const_cast<UObjectBase*>(Object)));
+		if (Classes.Num() == 0)
+		{
+			ClassesByPackage.Remove(PackageName);
+		}
+	}
+}
+
+bool FMonoScriptPackageClassIndex::IsStillInPackage(const UClass& Class, FName PackageName)
+{
+	return Class.GetOutermost()->GetFName() == PackageName;
+}
+
+void FMonoScriptPackageClassIndex::AddClass(UClass* Class)
+{
+	if (ClassPackages.Contains(Class))
+	{
+		return;
+	}
+
+	UPackage* Package = Class->GetOutermost();
+	check(Package);
+
+	ClassPackages.Add(Class, Package->GetFName());
+	ClassesByPackage.FindOrAdd(Package->GetFName()).Add(Class);
+	IndexedObjects[GUObjectArray.ObjectToIndex(Class)] = true;
+}
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/BitArray.h"
+#include "UObject/UObjectArray.h"
+
+// Index of loaded classes by package name, so loading bindings for a script package doesn't walk every class in the process.
+// Built with one pass over the loaded classes, then kept current by listening for UObject creation and deletion.
+// Class default objects are not indexed. Renames aren't reported to the listeners, so a class stays under the package it was
+// created in and queries skip it once it has moved out (hot reload renames replaced classes into the transient package).
+class FMonoScriptPackageClassIndex : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	FMonoScriptPackageClassIndex();
+	virtual ~FMonoScriptPackageClassIndex();
+
+	void GetClassesInPackage(FName PackageName, TArray<UClass*>& OutClasses) const;
+	void GetPackageNames(TSet<FName>& OutPackageNames) const;
+
+	// FUObjectCreateListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	// FUObjectDeleteListener
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+
+private:
+	// Caller must hold Lock
+	void AddClass(UClass* Class);
+	static bool IsStillInPackage(const UClass& Class, FName PackageName);
+
+	TMap<FName, TArray<UClass*>> ClassesByPackage;
+	// Package each indexed class was added under, so deletion doesn't have to touch a dying object's outer
+	TMap<const UObjectBase*, FName> ClassPackages;
+	// Set for the object array index of each indexed class, so deletion only takes the lock for classes we know about.
+	// Sized to the object array's capacity up front and never reallocated, so it can be read without the lock.
+	// Bits are only written under the lock.
+	TBitArray<> IndexedObjects;
+
+	// classes may be created and destroyed by the async loading thread
+	mutable FCriticalSection Lock;
+};
@@ -6,6 +6,7 @@
 #include "IMonoRuntime.h"
 #include "MonoHelpers.h"
 #include "PInvokeSignatures.h"
+#include "MonoBakedLayout.h"
 
 #include "CoreMinimal.h"
 #include "UObject/UnrealType.h"
@@ -101,6 +102,60 @@ MONO_PINVOKE_FUNCTION(int32) UnrealInterop_GetPropertyArrayDimFromName(UStruct*
 	return InProperty->ArrayDim;
 }
 
+MONO_PINVOKE_FUNCTION(void) UnrealInterop_GetNativePropertyInfos(UStruct* InStruct, const UTF16CHAR* InPropertyNames, int32 Count, FMonoNativePropertyInfo* OutInfos)
+{
+	check(InStruct);
+	check(OutInfos || Count == 0);
+
+	// Walk the field chain once rather than once per property. Derived fields come first, so like FindField the most derived property wins.
+	TMap<FName, UProperty*> PropertiesByName;
+	for (TFieldIterator<UProperty> PropIt(InStruct); PropIt; ++PropIt)
+	{
+		UProperty* Property = *PropIt;
+		if (!PropertiesByName.Contains(Property->GetFName()))
+		{
+			PropertiesByName.Add(Property->GetFName(), Property);
+		}
+	}
+
+	TArray<FString> PropertyNames;
+	FString(StringCast<TCHAR>(InPropertyNames).Get()).ParseIntoArray(PropertyNames, TEXT(";"));
+	checkf(PropertyNames.Num() == Count, TEXT("Expected %d property names for %s, got %d"), Count, *InStruct->GetName(), PropertyNames.Num());
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		UProperty* Property = PropertiesByName.FindRef(FName(*PropertyNames[Index], FNAME_Find));
+		checkf(Property, TEXT("Could not find property %s on %s"), *PropertyNames[Index], *InStruct->GetName());
+
+		FMonoNativePropertyInfo& Info = OutInfos[Index];
+		Info.Property = Property;
+		Info.Offset = Property->GetOffset_ForInternal();
+		Info.ArrayDim = Property->ArrayDim;
+		UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property);
+		Info.ArrayElementSize = ArrayProperty ? ArrayProperty->Inner->GetSize() : 0;
+	}
+}
+
+MONO_PINVOKE_FUNCTION(bool) UnrealInterop_ValidateBakedLayout(const UTF16CHAR* InModuleName, uint32 ExpectedHash)
+{
+	const FString ModuleName(StringCast<TCHAR>(InModuleName).Get());
+	UPackage* Package = FindPackage(nullptr, *FString::Printf(TEXT("/Script/%s"), *ModuleName));
+	if (!Package)
+	{
+		UE_LOG(LogMono, Warning, TEXT("Could not find package for module '%s', using dynamic property offsets for its bindings"), *ModuleName);
+		return false;
+	}
+
+	const uint32 ActualHash = Mono::ComputeBakedLayoutHash(*Package);
+	if (ActualHash != ExpectedHash)
+	{
+		UE_LOG(LogMono, Log, TEXT("Baked layout for module '%s' does not match this build (expected %08X, got %08X), using dynamic property offsets for its bindings"), *ModuleName, ExpectedHash, ActualHash);
+		return false;
+	}
+
+	return true;
+}
+
 MONO_PINVOKE_FUNCTION(bool) UnrealInterop_GetBitfieldValueFromProperty(uint8* NativeBuffer, UProperty* Property, int32 Offset)
 {
 	// NativeBuffer won't necessarily correspond to a UObject.  It might be the beginning of a native struct, for example.
@@ -161,6 +216,23 @@ void UnrealInterop_MarshalToUnrealString(MonoString* InString, FMarshalledScript
 #endif
 }
 
+MonoString* UnrealInterop_MoveUnrealStringToManaged(FString* InString)
+{
+	check(InString);
+	// Take ownership so the FString's allocation is released on return, leaving an empty string in the slot.
+	const FString String = MoveTemp(*InString);
+	MonoDomain* Domain = mono_domain_get();
+	if (String.Len() == 0)
+	{
+		return mono_string_empty(Domain);
+	}
+#if PLATFORM_TCHAR_IS_4_BYTES
+	return mono_string_new_utf32(Domain, reinterpret_cast<const mono_unichar4*>(*String), String.Len());
+#else
+	return mono_string_new_utf16(Domain, reinterpret_cast<const mono_unichar2*>(*String), String.Len());
+#endif
+}
+
 MONO_PINVOKE_FUNCTION(void) UnrealInterop_RPC_ResetLastFailedReason()
 {
 	RPC_ResetLastFailedReason();
@@ -14,6 +14,7 @@
 #include "Misc/FeedbackContext.h"
 
 #include "MonoBindings.h"
+#include "MonoWrapperPool.h"
 #include "PInvokeSignatures.h"
 
 #include <mono/metadata/exception.h>
@@ -43,6 +44,12 @@ MonoObject* UnrealObject_GetUnrealObjectWrapper(UObject* Object)
 	return FMonoBindings::Get().GetUnrealObjectWrapper(Object);
 }
 
+bool UnrealObject_ReturnWrapperToPool(MonoObject* Wrapper)
+{
+	// called from the finalizer of [PooledWrapper] classes, on the managed finalizer thread
+	return FMonoWrapperPool::Get().Release(Wrapper);
+}
+
 MonoObject* UnrealObject_ConstructUnrealObject(MonoReflectionType* InReturnType, UClass* InClass, UObject* InOuter, FName InObjectName, EObjectFlags SetFlags, UObject* Template, bool bCopyTransientsFromClassDefaults, struct FObjectInstancingGraph* InstanceGraph, bool bAssumeTemplateIsArchetype)
 {
 	FMonoBindings& Bindings = FMonoBindings::Get();
@@ -533,11 +540,13 @@ void Name_CheckSizeof(int structSize)
 
 MonoString* UnrealInterop_MarshalIntPtrAsString(TCHAR* InString);
 void UnrealInterop_MarshalToUnrealString(MonoString* InString, FMarshalledScriptArray* OutArray);
+MonoString* UnrealInterop_MoveUnrealStringToManaged(FString* InString);
 
 void AddUnrealObjectInternalCalls()
 {
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::IsPendingKillNative", UnrealObject_IsPendingKill);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::GetUnrealObjectWrapperNative", UnrealObject_GetUnrealObjectWrapper);
+	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::ReturnWrapperToPoolNative", UnrealObject_ReturnWrapperToPool);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::ConstructUnrealObjectNative", UnrealObject_ConstructUnrealObject);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::GetDefaultObjectFromUnrealClass", UnrealObject_GetDefaultObjectFromUnrealClass);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::GetDefaultObjectFromMonoClass", UnrealObject_GetDefaultObjectFromMonoType);
@@ -548,6 +557,7 @@ void AddUnrealObjectInternalCalls()
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealInterop::GetNativeClassFromType", UClass_GetNativeClassFromType);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealInterop::MarshalIntPtrAsString", UnrealInterop_MarshalIntPtrAsString);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealInterop::MarshalToUnrealString", UnrealInterop_MarshalToUnrealString);
+	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealInterop::MoveUnrealStringToManaged", UnrealInterop_MoveUnrealStringToManaged);
 
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::ObjectFinder_FindNativeObject", ObjectFinder_FindNativeObject);
 	MONO_ADD_INTERNAL_CALL(MONO_BINDINGS_NAMESPACE ".UnrealObject::ClassFinder_FindNativeClass", ClassFinder_FindNativeClass);
@@ -675,36 +685,17 @@ MONO_PINVOKE_FUNCTION(void) UnrealObject_InvokeFunction(UObject* NativeObject, U
 		if (IsOutParam(ParamProperty))
 		{
 			uint8* ParamMemory = reinterpret_cast<uint8*>(Arguments)+ParamProperty->GetOffset_ForUFunction();
-			if (UStrProperty* StringProperty = Cast<UStrProperty>(ParamProperty))
+			if (ParamProperty->IsA<UStrProperty>())
 			{
-				FString* String = reinterpret_cast<FString*>(ParamMemory);
-				int32 Length = String->Len() + 1;
-				TCHAR* ReturnBuffer = reinterpret_cast<TCHAR*>(Mono::CoTaskMemAlloc(Length * sizeof(TCHAR)));
-				FCString::Strcpy(ReturnBuffer, Length, **String);
-
-				ParamProperty->DestroyValue(ParamMemory);
-
-				FMarshalledScriptArray* MarshalledString = reinterpret_cast<FMarshalledScriptArray*>(ParamMemory);
-				MarshalledString->Data = ReturnBuffer;
-				MarshalledString->ArrayNum = MarshalledString->ArrayMax = Length;
+				// Strings are left in place as live FStrings. The generated invoker moves each one straight into
+				// a MonoString with UnrealInterop.MoveUnrealStringToManaged, which also frees the FString, so we
+				// don't need an intermediate CoTaskMem copy.
 			}
-			else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(ParamProperty))
+			else if (ParamProperty->IsA<UArrayProperty>())
 			{
-				FScriptArray* ScriptArray = reinterpret_cast<FScriptArray*>(ParamMemory);
-				int ArrayNum = ScriptArray->Num();
-
-				//TODO: handle non-blittable inner properties.
-				//      Currently, only simple types, structs, and UObject*s are permitted by the code generator.
-				UProperty* InnerProperty = ArrayProperty->Inner;
-				size_t BufferSize = InnerProperty->ElementSize * ArrayNum;
-				void* ReturnBuffer = Mono::CoTaskMemAlloc(BufferSize);
-				FMemory::Memcpy(ReturnBuffer, ScriptArray->GetData(), BufferSize);
-
-				ParamProperty->DestroyValue(ParamMemory);
-
-				FMarshalledScriptArray* MarshalledScriptArray = reinterpret_cast<FMarshalledScriptArray*>(ParamMemory);
-				MarshalledScriptArray->Data = ReturnBuffer;
-				MarshalledScriptArray->ArrayNum = MarshalledScriptArray->ArrayMax = ArrayNum;
+				// Arrays are also left in place. The generated invoker takes over the allocation with UnrealArrayOwned
+				// when the elements are blittable, and otherwise copies the elements out and frees it through UnrealArrayOwned_Free,
+				// which destroys the elements through the array property.
 			}
 			else
 			{
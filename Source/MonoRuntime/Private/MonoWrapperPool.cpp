@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#include "MonoWrapperPool.h"
+#include "MonoRuntimePrivate.h"
+#include "MonoRuntimeCommon.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+#include <mono/metadata/appdomain.h>
+#include <mono/metadata/reflection.h>
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wrapper Pool Hits"), STAT_MonoWrapperPoolHits, STATGROUP_Mono);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wrapper Pool Misses"), STAT_MonoWrapperPoolMisses, STATGROUP_Mono);
+
+static int32 GMonoWrapperPoolMaxPerClass = 64;
+static FAutoConsoleVariableRef CVarMonoWrapperPoolMaxPerClass(
+	TEXT("MonoRuntime.WrapperPool.MaxPerClass"),
+	GMonoWrapperPoolMaxPerClass,
+	TEXT("Maximum number of detached wrappers kept for reuse per [PooledWrapper] class (0 disables wrapper pooling)."),
+	ECVF_Default);
+
+FMonoWrapperPool& FMonoWrapperPool::Get()
+{
+	static FMonoWrapperPool WrapperPool;
+	return WrapperPool;
+}
+
+FMonoWrapperPool::FMonoWrapperPool()
+	: Domain(nullptr)
+	, NativeObjectField(nullptr)
+	, PooledWrapperAttributeClass(nullptr)
+{
+	static FAutoConsoleCommand DumpStatsCommand(
+		TEXT("MonoRuntime.WrapperPool.Stats"),
+		TEXT("Log wrapper pool hits, misses and the number of pooled wrappers per class."),
+		FConsoleCommandDelegate::CreateRaw(this, &FMonoWrapperPool::DumpStats));
+}
+
+FMonoWrapperPool::~FMonoWrapperPool()
+{
+	// by now the domain is gone along with anything we were holding on to
+	Pools.Empty();
+}
+
+void FMonoWrapperPool::Initialize(MonoDomain* InDomain, MonoClassField* InNativeObjectField, MonoClass* InPooledWrapperAttributeClass)
+{
+	check(InDomain);
+	check(InNativeObjectField);
+	check(InPooledWrapperAttributeClass);
+
+	FScopeLock Lock(&CriticalSection);
+	check(nullptr == Domain);
+	Domain = InDomain;
+	NativeObjectField = InNativeObjectField;
+	PooledWrapperAttributeClass = InPooledWrapperAttributeClass;
+}
+
+void FMonoWrapperPool::RegisterWrapperClass(MonoClass* WrapperClass)
+{
+	check(WrapperClass);
+	check(IsInGameThread());
+
+	if (GMonoWrapperPoolMaxPerClass <= 0 || nullptr == PooledWrapperAttributeClass)
+	{
+		return;
+	}
+
+	bool bPooled = false;
+	MonoCustomAttrInfo* WrapperClassAttributes = mono_custom_attrs_from_class(WrapperClass);
+	if (nullptr != WrapperClassAttributes)
+	{
+		bPooled = !!mono_custom_attrs_has_attr(WrapperClassAttributes, PooledWrapperAttributeClass);
+		mono_custom_attrs_free(WrapperClassAttributes);
+	}
+	if (!bPooled)
+	{
+		return;
+	}
+
+	MonoArray* Array = mono_array_new(Domain, mono_get_object_class(), GMonoWrapperPoolMaxPerClass);
+
+	FScopeLock Lock(&CriticalSection);
+	if (!Pools.Contains(WrapperClass))
+	{
+		FClassPool& Pool = Pools.Add(WrapperClass);
+		Pool.ArrayGCHandle = mono_gchandle_new((MonoObject*)Array, false);
+		Pool.Capacity = GMonoWrapperPoolMaxPerClass;
+		Pool.Num = 0;
+	}
+}
+
+MonoObject* FMonoWrapperPool::Acquire(MonoClass* WrapperClass, UObject& InObject)
+{
+	MonoObject* Wrapper = nullptr;
+	{
+		FScopeLock Lock(&CriticalSection);
+		FClassPool* Pool = Pools.Find(WrapperClass);
+		if (nullptr == Pool)
+		{
+			// not a pooled class
+			return nullptr;
+		}
+
+		if (Pool->Num > 0)
+		{
+			MonoArray* Array = (MonoArray*)mono_gchandle_get_target(Pool->ArrayGCHandle);
+			--Pool->Num;
+			Wrapper = mono_array_get(Array, MonoObject*, Pool->Num);
+			mono_array_setref(Array, Pool->Num, nullptr);
+		}
+	}
+
+	if (nullptr == Wrapper)
+	{
+		NumMisses.Increment();
+		INC_DWORD_STAT(STAT_MonoWrapperPoolMisses);
+		return nullptr;
+	}
+
+	// this is all the wrapping constructor does
+	UObject* NativeObject = &InObject;
+	mono_field_set_value(Wrapper, NativeObjectField, &NativeObject);
+
+	NumHits.Increment();
+	INC_DWORD_STAT(STAT_MonoWrapperPoolHits);
+	return Wrapper;
+}
+
+bool FMonoWrapperPool::Release(MonoObject* Wrapper)
+{
+	check(Wrapper);
+
+	FScopeLock Lock(&CriticalSection);
+
+	// finalizers still run for objects in a domain that is being reloaded or shut down
+	if (nullptr == Domain || mono_object_get_domain(Wrapper) != Domain)
+	{
+		return false;
+	}
+
+	// user classes deriving from a pooled wrapper class inherit its finalizer, but only the wrapper class itself is pooled
+	FClassPool* Pool = Pools.Find(mono_object_get_class(Wrapper));
+	if (nullptr == Pool || Pool->Num >= FMath::Min(Pool->Capacity, GMonoWrapperPoolMaxPerClass))
+	{
+		return false;
+	}
+
+	MonoArray* Array = (MonoArray*)mono_gchandle_get_target(Pool->ArrayGCHandle);
+	mono_array_setref(Array, Pool->Num, Wrapper);
+	++Pool->Num;
+	return true;
+}
+
+void FMonoWrapperPool::Empty()
+{
+	FScopeLock Lock(&CriticalSection);
+	for (auto&& Pair : Pools)
+	{
+		mono_gchandle_free(Pair.Value.ArrayGCHandle);
+	}
+	Pools.Empty();
+	Domain = nullptr;
+	NativeObjectField = nullptr;
+	PooledWrapperAttributeClass = nullptr;
+}
+
+void FMonoWrapperPool::DumpStats()
+{
+	FScopeLock Lock(&CriticalSection);
+	UE_LOG(LogMono, Display, TEXT("Wrapper pool: %d hits, %d misses"), NumHits.GetValue(), NumMisses.GetValue());
+	for (auto&& Pair : Pools)
+	{
+		UE_LOG(LogMono, Display, TEXT("  %s.%s: %d pooled"), ANSI_TO_TCHAR(mono_class_get_namespace(Pair.Key)), ANSI_TO_TCHAR(mono_class_get_name(Pair.Key)), Pair.Value.Num);
+	}
+}
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <mono/metadata/class.h>
+#include <mono/metadata/object.h>
+
+// Per wrapper class pool of detached wrapper objects, for wrapper classes which opt in with [PooledWrapper].
+// Those classes declare a finalizer which hands unreachable wrappers back to the pool, and the next wrapper of that class is
+// re-targeted at its new native object by writing _NativeObject directly, instead of allocating and running the wrapping constructor.
+// Other wrapper classes are never finalizable, and are never pooled.
+// Wrappers may be released from the finalizer thread and acquired from worker threads, so the pool is guarded by a lock.
+class FMonoWrapperPool
+{
+public:
+	// the pool outlives the bindings, so finalizers which run during shutdown always have something to talk to
+	static FMonoWrapperPool& Get();
+
+	~FMonoWrapperPool();
+
+	void Initialize(MonoDomain* InDomain, MonoClassField* InNativeObjectField, MonoClass* InPooledWrapperAttributeClass);
+	// creates a pool for the wrapper class if it is marked [PooledWrapper], game thread only
+	void RegisterWrapperClass(MonoClass* WrapperClass);
+
+	// returns a pooled wrapper re-targeted at InObject, or null if none are pooled for the class
+	MonoObject* Acquire(MonoClass* WrapperClass, UObject& InObject);
+	// returns true if the wrapper was kept, in which case it must be re-registered for finalization
+	bool Release(MonoObject* Wrapper);
+
+	// drops all pooled wrappers and stops accepting new ones until the next Initialize
+	void Empty();
+
+	int32 GetNumHits() const { return NumHits.GetValue(); }
+	int32 GetNumMisses() const { return NumMisses.GetValue(); }
+
+private:
+	FMonoWrapperPool();
+
+	void DumpStats();
+
+	// Pooled wrappers are stored in a managed object[] held by a single strong GC handle, which is allocated up front
+	// so releasing a wrapper on the finalizer thread is just a store into the array.
+	struct FClassPool
+	{
+		uint32_t ArrayGCHandle;
+		int32 Capacity;
+		int32 Num;
+	};
+
+	FCriticalSection CriticalSection;
+	MonoDomain* Domain;
+	MonoClassField* NativeObjectField;
+	MonoClass* PooledWrapperAttributeClass;
+	TMap<MonoClass*, FClassPool> Pools;
+
+	FThreadSafeCounter NumHits;
+	FThreadSafeCounter NumMisses;
+};
@@ -20,10 +20,26 @@ MONO_PINVOKE_FUNCTION(void) ScriptArrayBase_AddToArray(UProperty* ArrayProperty,
 MONO_PINVOKE_FUNCTION(void) ScriptArrayBase_InsertInArray(UProperty* ArrayProperty, void* ScriptArray, int index);
 MONO_PINVOKE_FUNCTION(void) ScriptArrayBase_RemoveFromArray(UProperty* ArrayProperty, void* ScriptArray, int index);
 
+// UnrealEngine.Runtime.UnrealArrayOwned pinvokes, implemented in MonoScriptArrayBase.cpp
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Insert(FScriptArray* ScriptArray, int Index, int Count, int ElementSize);
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Remove(FScriptArray* ScriptArray, int Index, int Count, int ElementSize);
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Free(UProperty* ArrayProperty, FScriptArray* ScriptArray);
+MONO_PINVOKE_FUNCTION(void) UnrealArrayOwned_Empty(FScriptArray* ScriptArray, int ElementSize);
+
 // PInvoke for LogStream class, implemented in MonoLogTextWriter.cpp
 MONO_PINVOKE_FUNCTION(void) LogTextWriter_Serialize(const UTF16CHAR* String, unsigned int readOffset);
 
 // MonoUnrealInterop.cpp
+// Layout must match UnrealEngine.Runtime.UnrealInterop.NativePropertyInfo
+struct FMonoNativePropertyInfo
+{
+	UProperty* Property;
+	int32 Offset;
+	int32 ArrayDim;
+	// Inner element size for array properties, zero otherwise
+	int32 ArrayElementSize;
+};
+
 MONO_PINVOKE_FUNCTION(void) Bindings_OnUnhandledExceptionNative(const UTF16CHAR* InMessage, const UTF16CHAR* InStackTrace);
 MONO_PINVOKE_FUNCTION(UClass*) UnrealInterop_GetNativeClassFromName(const UTF16CHAR* InClassName);
 MONO_PINVOKE_FUNCTION(UStruct*) UnrealInterop_GetNativeStructFromName(const UTF16CHAR* InStructName);
@@ -33,6 +49,8 @@ MONO_PINVOKE_FUNCTION(UProperty*) UnrealInterop_GetNativePropertyFromName(UStruc
 MONO_PINVOKE_FUNCTION(uint16) UnrealInterop_GetPropertyRepIndexFromName(UStruct* Struct, const UTF16CHAR* PropertyName);
 MONO_PINVOKE_FUNCTION(int32) UnrealInterop_GetArrayElementSize(UStruct* Struct, const UTF16CHAR* PropertyName);
 MONO_PINVOKE_FUNCTION(int32) UnrealInterop_GetPropertyArrayDimFromName(UStruct* InStruct, const UTF16CHAR* InPropertyName);
+MONO_PINVOKE_FUNCTION(void) UnrealInterop_GetNativePropertyInfos(UStruct* InStruct, const UTF16CHAR* InPropertyNames, int32 Count, FMonoNativePropertyInfo* OutInfos);
+MONO_PINVOKE_FUNCTION(bool) UnrealInterop_ValidateBakedLayout(const UTF16CHAR* InModuleName, uint32 ExpectedHash);
 MONO_PINVOKE_FUNCTION(bool) UnrealInterop_GetBitfieldValueFromProperty(uint8* NativeBuffer, UProperty* Property, int32 Offset);
 MONO_PINVOKE_FUNCTION(void) UnrealInterop_SetBitfieldValueForProperty(uint8* NativeObject, UProperty* Property, int32 Offset, bool Value);
 MONO_PINVOKE_FUNCTION(void) UnrealInterop_SetStringValueForProperty(UObject* NativeObject, UProperty* Property, int32 Offset, const UTF16CHAR* Value);
@@ -38,6 +38,10 @@ static void MonoPInvokeRegisterFunctions_MonoRuntime()
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("ScriptArrayBase_AddToArray")), (void*)ScriptArrayBase_AddToArray);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("ScriptArrayBase_InsertInArray")), (void*)ScriptArrayBase_InsertInArray);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("ScriptArrayBase_RemoveFromArray")), (void*)ScriptArrayBase_RemoveFromArray);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealArrayOwned_Insert")), (void*)UnrealArrayOwned_Insert);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealArrayOwned_Remove")), (void*)UnrealArrayOwned_Remove);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealArrayOwned_Free")), (void*)UnrealArrayOwned_Free);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealArrayOwned_Empty")), (void*)UnrealArrayOwned_Empty);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetNativeClassFromName")), (void*)UnrealInterop_GetNativeClassFromName);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetNativeStructFromName")), (void*)UnrealInterop_GetNativeStructFromName);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetNativeStructSize")), (void*)UnrealInterop_GetNativeStructSize);
@@ -46,6 +50,8 @@ static void MonoPInvokeRegisterFunctions_MonoRuntime()
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetPropertyRepIndexFromName")), (void*)UnrealInterop_GetPropertyRepIndexFromName);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetArrayElementSize")), (void*)UnrealInterop_GetArrayElementSize);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetPropertyArrayDimFromName")), (void*)UnrealInterop_GetPropertyArrayDimFromName);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetNativePropertyInfos")), (void*)UnrealInterop_GetNativePropertyInfos);
+	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_ValidateBakedLayout")), (void*)UnrealInterop_ValidateBakedLayout);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_GetBitfieldValueFromProperty")), (void*)UnrealInterop_GetBitfieldValueFromProperty);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_SetBitfieldValueForProperty")), (void*)UnrealInterop_SetBitfieldValueForProperty);
 	MonoPInvokeFunctionMap_MonoRuntime.Add(FString(TEXT("UnrealInterop_SetStringValueForProperty")), (void*)UnrealInterop_SetStringValueForProperty);
@@ -4,8 +4,22 @@
 #include "MonoRuntimePrivate.h"
 #include "MonoBindings.h"
 #include "MonoHelpers.h"
+#include "PInvokeSignatures.h"
 #include "Tests/MonoTestsObject.h"
+#include "Tests/MonoTestSubObject.h"
+#include "Tests/MonoTestPooledObject.h"
+#include "MonoWrapperPool.h"
 #include "Misc/AutomationTest.h"
+#include "Stats/StatsMisc.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "GameFramework/Actor.h"
+#include "MonoScriptPackageClassIndex.h"
+#include "MonoAssemblyMetadata.h"
+#include "MonoBakedLayout.h"
+#include "UObject/UObjectIterator.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
 
 // Disable GC tests until we can disable consideration of main thread's stack
 #define MONO_HACK_GC_TEST_UNTIL_HAVE_MORE_CONTROL 1
@@ -73,3 +87,716 @@ bool FMonoRuntimeGCTests::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeObjectTableCompanionTests, "MonoRuntime.Mono Object Table Companion Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMonoRuntimeObjectTableCompanionTests::RunTest(const FString& Parameters)
+{
+	FMonoBindings& Bindings = FMonoBindings::Get();
+	MonoMethod* ClearNativePointersMethod = Bindings.GetBindingsAssembly().LookupMethod(MONO_BINDINGS_NAMESPACE ".UnrealObject:ClearNativePointers");
+	check(ClearNativePointersMethod);
+	MonoClass* WrapperClass = Bindings.GetMonoClassFromUnrealClass(*UMonoTestSubObject::StaticClass());
+	check(WrapperClass);
+	MonoMethod* WrapperConstructor = Mono::LookupMethodOnClass(WrapperClass, ":.ctor(intptr)");
+	check(WrapperConstructor);
+	MonoClass* UnrealObjectClass = Bindings.GetBindingsAssembly().GetClass(MONO_BINDINGS_NAMESPACE, "UnrealObject");
+	check(UnrealObjectClass);
+	MonoClassField* NativeObjectField = mono_class_get_field_from_name(UnrealObjectClass, "_NativeObject");
+	check(NativeObjectField);
+
+	// a table of our own, so the test doesn't disturb the wrappers the bindings track
+	FMonoObjectTable Table;
+	Table.Initialize(Bindings, ClearNativePointersMethod);
+
+	UMonoTestSubObject* Object = NewObject<UMonoTestSubObject>();
+
+	// a wrapper published the way worker threads publish them, before the companion is set
+	MonoObject* Wrapper = Mono::ConstructObject(Bindings, WrapperClass, WrapperConstructor, (PTRINT)Object);
+	const uint32_t WrapperHandle = mono_gchandle_new(Wrapper, false);
+	TestTrue(MONO_TEST_TEXT("Published wrapper is in the table"), Table.AddWrapperObject(*Object, Wrapper) == Wrapper);
+
+	MonoObject* Companion = Mono::ConstructObject(Bindings, WrapperClass, WrapperConstructor, (PTRINT)Object);
+	const uint32_t CompanionHandle = mono_gchandle_new(Companion, false);
+	Table.AddCompanionObject(*Object, Companion);
+
+	TestTrue(MONO_TEST_TEXT("Companion replaced the published wrapper"), Table.GetManagedObject(*Object) == mono_gchandle_get_target(CompanionHandle));
+
+	UObject* WrapperNativeObject = Object;
+	mono_field_get_value(mono_gchandle_get_target(WrapperHandle), NativeObjectField, &WrapperNativeObject);
+	TestTrue(MONO_TEST_TEXT("Replaced wrapper's native pointer is cleared"), nullptr == WrapperNativeObject);
+
+	Table.RemoveObject(*Object);
+	mono_gchandle_free(CompanionHandle);
+	mono_gchandle_free(WrapperHandle);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeWrapperPoolTests, "MonoRuntime.Mono Wrapper Pool Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMonoRuntimeWrapperPoolTests::RunTest(const FString& Parameters)
+{
+	FMonoBindings& Bindings = FMonoBindings::Get();
+	FMonoWrapperPool& WrapperPool = FMonoWrapperPool::Get();
+	MonoClass* WrapperClass = Bindings.GetMonoClassFromUnrealClass(*UMonoTestPooledObject::StaticClass());
+	check(WrapperClass);
+	MonoClass* UnrealObjectClass = Bindings.GetBindingsAssembly().GetClass(MONO_BINDINGS_NAMESPACE, "UnrealObject");
+	check(UnrealObjectClass);
+	MonoClassField* NativeObjectField = mono_class_get_field_from_name(UnrealObjectClass, "_NativeObject");
+	check(NativeObjectField);
+
+	// a detached wrapper, as ReturnToWrapperPool hands it back from the finalizer
+	MonoObject* DetachedWrapper = mono_object_new(Bindings.GetDomain(), WrapperClass);
+	const uint32_t DetachedWrapperHandle = mono_gchandle_new(DetachedWrapper, false);
+	TestTrue(MONO_TEST_TEXT("Wrapper of a [PooledWrapper] class is kept"), WrapperPool.Release(DetachedWrapper));
+
+	const int32 NumHits = WrapperPool.GetNumHits();
+
+	// the pool is last in, first out, so the next wrapper of the class is the one just released
+	UMonoTestPooledObject* Object = NewObject<UMonoTestPooledObject>();
+	MonoObject* Wrapper = Bindings.GetUnrealObjectWrapper(Object);
+	TestTrue(MONO_TEST_TEXT("Pooled wrapper is reused"), Wrapper == mono_gchandle_get_target(DetachedWrapperHandle));
+	TestEqual(MONO_TEST_TEXT("Reuse counts as a hit"), WrapperPool.GetNumHits(), NumHits + 1);
+
+	UObject* WrapperNativeObject = nullptr;
+	mono_field_get_value(Wrapper, NativeObjectField, &WrapperNativeObject);
+	TestTrue(MONO_TEST_TEXT("Reused wrapper is re-targeted at the new object"), WrapperNativeObject == Object);
+
+	// wrappers of classes which don't opt in are never pooled
+	MonoClass* UnpooledWrapperClass = Bindings.GetMonoClassFromUnrealClass(*UMonoTestSubObject::StaticClass());
+	check(UnpooledWrapperClass);
+	TestFalse(MONO_TEST_TEXT("Wrapper of an unpooled class is not kept"), WrapperPool.Release(mono_object_new(Bindings.GetDomain(), UnpooledWrapperClass)));
+
+	mono_gchandle_free(DetachedWrapperHandle);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeObjectTablePerfTests, "MonoRuntime.Mono Object Table Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeObjectTablePerfTests::RunTest(const FString& Parameters)
+{
+	static const int32 TrackedObjectCounts[] = { 10000, 100000, 1000000 };
+
+	FMonoBindings& Bindings = FMonoBindings::Get();
+
+	for (int32 NumObjects : TrackedObjectCounts)
+	{
+		TArray<UMonoTestSubObject*> Objects;
+		// keep the wrappers alive so lookups hit the table and GC has to trace every entry
+		TArray<uint32> WrapperHandles;
+		Objects.Reserve(NumObjects);
+		WrapperHandles.Reserve(NumObjects);
+
+		for (int32 i = 0; i < NumObjects; ++i)
+		{
+			UMonoTestSubObject* Object = NewObject<UMonoTestSubObject>();
+			Object->AddToRoot();
+			Objects.Add(Object);
+			WrapperHandles.Add(mono_gchandle_new(Bindings.GetUnrealObjectWrapper(Object), false));
+		}
+
+		double LookupTime = 0.0;
+		{
+			SCOPE_SECONDS_COUNTER(LookupTime);
+			for (UMonoTestSubObject* Object : Objects)
+			{
+				Bindings.GetUnrealObjectWrapper(Object);
+			}
+		}
+
+		double GCTime = 0.0;
+		{
+			SCOPE_SECONDS_COUNTER(GCTime);
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		UE_LOG(LogMono, Display, TEXT("%d tracked objects: wrapper lookup %g ns/object, garbage collection %g ms"), NumObjects, LookupTime * 1e9 / NumObjects, GCTime * 1000.0);
+
+		// checked outside the timed loop, and after GC so the table has to have kept every entry
+		int32 NumMismatchedWrappers = 0;
+		for (int32 i = 0; i < NumObjects; ++i)
+		{
+			if (Bindings.GetUnrealObjectWrapper(Objects[i]) != mono_gchandle_get_target(WrapperHandles[i]))
+			{
+				++NumMismatchedWrappers;
+			}
+		}
+		TestEqual(MONO_TEST_TEXT("Lookups return the tracked wrapper for %d objects", NumObjects), NumMismatchedWrappers, 0);
+
+		for (uint32 WrapperHandle : WrapperHandles)
+		{
+			mono_gchandle_free(WrapperHandle);
+		}
+		for (UMonoTestSubObject* Object : Objects)
+		{
+			Object->RemoveFromRoot();
+		}
+		Objects.Empty();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeWrapperConstructionPerfTests, "MonoRuntime.Mono Wrapper Construction Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeWrapperConstructionPerfTests::RunTest(const FString& Parameters)
+{
+	static const int32 NumWrappers = 100000;
+
+	FMonoBindings& Bindings = FMonoBindings::Get();
+	MonoClass* WrapperClass = Bindings.GetMonoClassFromUnrealClass(*UMonoTestSubObject::StaticClass());
+	check(WrapperClass);
+	MonoMethod* WrapperConstructor = Mono::LookupMethodOnClass(WrapperClass, ":.ctor(intptr)");
+	check(WrapperConstructor);
+	MonoClass* UnrealObjectClass = Bindings.GetBindingsAssembly().GetClass(MONO_BINDINGS_NAMESPACE, "UnrealObject");
+	check(UnrealObjectClass);
+	MonoClassField* NativeObjectField = mono_class_get_field_from_name(UnrealObjectClass, "_NativeObject");
+	check(NativeObjectField);
+
+	UMonoTestSubObject* Object = NewObject<UMonoTestSubObject>();
+
+	// reads back the native pointer of the last wrapper each path constructed, so a broken path fails the test
+	auto TestNativeObject = [this, NativeObjectField, Object](const TCHAR* PathName, MonoObject* Wrapper)
+	{
+		UObject* WrapperNativeObject = nullptr;
+		mono_field_get_value(Wrapper, NativeObjectField, &WrapperNativeObject);
+		TestTrue(MONO_TEST_TEXT("%s sets _NativeObject", PathName), WrapperNativeObject == Object);
+	};
+
+	// wrappers are thrown away immediately, this measures the construction paths only
+	MonoObject* LastWrapper = nullptr;
+	double ConstructorTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(ConstructorTime);
+		for (int32 i = 0; i < NumWrappers; ++i)
+		{
+			LastWrapper = Mono::ConstructObject(Bindings, WrapperClass, WrapperConstructor, (PTRINT)Object);
+		}
+	}
+	TestNativeObject(TEXT("Constructor invoke"), LastWrapper);
+
+	double ThunkTime = 0.0;
+	{
+		TMonoThunk<void(MonoObject*, UObject*)> WrapperConstructorThunk(WrapperConstructor);
+		SCOPE_SECONDS_COUNTER(ThunkTime);
+		for (int32 i = 0; i < NumWrappers; ++i)
+		{
+			LastWrapper = mono_object_new(Bindings.GetDomain(), WrapperClass);
+			WrapperConstructorThunk.Invoke(Bindings, LastWrapper, Object);
+		}
+	}
+	TestNativeObject(TEXT("Constructor thunk"), LastWrapper);
+
+	double FieldWriteTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(FieldWriteTime);
+		for (int32 i = 0; i < NumWrappers; ++i)
+		{
+			LastWrapper = mono_object_new(Bindings.GetDomain(), WrapperClass);
+			mono_field_set_value(LastWrapper, NativeObjectField, &Object);
+		}
+	}
+	TestNativeObject(TEXT("Direct field write"), LastWrapper);
+
+	UE_LOG(LogMono, Display, TEXT("%d wrappers: constructor invoke %g ns/wrapper, constructor thunk %g ns/wrapper, direct field write %g ns/wrapper"), NumWrappers, ConstructorTime * 1e9 / NumWrappers, ThunkTime * 1e9 / NumWrappers, FieldWriteTime * 1e9 / NumWrappers);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeBlittableMarshalingPerfTests, "MonoRuntime.Mono Blittable Marshaling Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeBlittableMarshalingPerfTests::RunTest(const FString& Parameters)
+{
+	static const int32 NumVectors = 10000;
+	static const int32 NumIterations = 100;
+
+	UMonoTestsObject* TestsObject = NewObject<UMonoTestsObject>();
+	TestsObject->Tester = this;
+
+	FMonoBindings& Bindings = FMonoBindings::Get();
+	MonoClass* TestsObjectClass = Bindings.GetMonoClassFromUnrealClass(*UMonoTestsObject::StaticClass());
+	check(TestsObjectClass);
+
+	MonoMethod* BenchmarkMethod = Mono::LookupMethodOnClass(TestsObjectClass, ":BenchmarkVectorArrayIteration(int,int)");
+	check(BenchmarkMethod);
+
+	// timings are logged from managed code
+	Mono::Invoke<void>(Bindings, BenchmarkMethod, Bindings.GetUnrealObjectWrapper(TestsObject), NumVectors, NumIterations);
+
+	return true;
+}
+
+MonoString* UnrealInterop_MarshalIntPtrAsString(TCHAR* InString);
+MonoString* UnrealInterop_MoveUnrealStringToManaged(FString* InString);
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeStringReturnPerfTests, "MonoRuntime.Mono String Return Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeStringReturnPerfTests::RunTest(const FString& Parameters)
+{
+	static const int32 NumCalls = 100000;
+
+	UClass* LibraryClass = UKismetSystemLibrary::StaticClass();
+	UFunction* GetDisplayNameFunction = LibraryClass->FindFunctionByName(TEXT("GetDisplayName"));
+	check(GetDisplayNameFunction);
+	UObjectProperty* ObjectParam = FindField<UObjectProperty>(GetDisplayNameFunction, TEXT("Object"));
+	check(ObjectParam);
+	UProperty* ReturnProperty = GetDisplayNameFunction->GetReturnProperty();
+	check(ReturnProperty && ReturnProperty->IsA<UStrProperty>());
+
+	UMonoTestSubObject* Object = NewObject<UMonoTestSubObject>();
+
+	TArray<uint8, TAlignedHeapAllocator<16>> ParamsBuffer;
+	ParamsBuffer.AddZeroed(GetDisplayNameFunction->ParmsSize);
+	ObjectParam->SetObjectPropertyValue_InContainer(ParamsBuffer.GetData(), Object);
+	FString* ReturnValue = ReturnProperty->ContainerPtrToValuePtr<FString>(ParamsBuffer.GetData());
+
+	const FString ExpectedDisplayName = UKismetSystemLibrary::GetDisplayName(Object);
+	FString Result;
+
+	// the previous path: copy the returned FString into a CoTaskMem buffer, then create the managed string from that and free it
+	MonoString* LastString = nullptr;
+	double CopyTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(CopyTime);
+		for (int32 i = 0; i < NumCalls; ++i)
+		{
+			ReturnProperty->InitializeValue(ReturnValue);
+			LibraryClass->ClassDefaultObject->ProcessEvent(GetDisplayNameFunction, ParamsBuffer.GetData());
+
+			int32 Length = ReturnValue->Len() + 1;
+			TCHAR* CopyBuffer = reinterpret_cast<TCHAR*>(Mono::CoTaskMemAlloc(Length * sizeof(TCHAR)));
+			FCString::Strcpy(CopyBuffer, Length, **ReturnValue);
+			ReturnProperty->DestroyValue(ReturnValue);
+
+			LastString = UnrealInterop_MarshalIntPtrAsString(CopyBuffer);
+			Mono::CoTaskMemFree(CopyBuffer);
+		}
+	}
+	Mono::MonoStringToFString(Result, LastString);
+	TestEqual(MONO_TEST_TEXT("Copied GetDisplayName result"), Result, ExpectedDisplayName);
+
+	double MoveTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(MoveTime);
+		for (int32 i = 0; i < NumCalls; ++i)
+		{
+			UnrealObject_InvokeStaticFunction(LibraryClass, GetDisplayNameFunction, ParamsBuffer.GetData(), GetDisplayNameFunction->ParmsSize);
+			LastString = UnrealInterop_MoveUnrealStringToManaged(ReturnValue);
+		}
+	}
+	Mono::MonoStringToFString(Result, LastString);
+	TestEqual(MONO_TEST_TEXT("Moved GetDisplayName result"), Result, ExpectedDisplayName);
+	TestTrue(MONO_TEST_TEXT("Moved FString is empty"), ReturnValue->IsEmpty());
+
+	// contents survive the move whatever they hold, including the empty string shortcut and characters outside ASCII
+	static const TCHAR* const MovedStrings[] = { TEXT(""), TEXT("Catch_22"), TEXT("Caf\x00e9 \x65e5\x672c"), TEXT("Line\nBreak") };
+	for (const TCHAR* MovedString : MovedStrings)
+	{
+		FString Original = MovedString;
+		Mono::MonoStringToFString(Result, UnrealInterop_MoveUnrealStringToManaged(&Original));
+		TestEqual(MONO_TEST_TEXT("Moved string '%s'", MovedString), Result, FString(MovedString));
+		TestTrue(MONO_TEST_TEXT("Moved FString '%s' is empty", MovedString), Original.IsEmpty());
+	}
+
+	UE_LOG(LogMono, Display, TEXT("%d GetDisplayName calls: CoTaskMem copy %g ns/call, direct MonoString %g ns/call"), NumCalls, CopyTime * 1e9 / NumCalls, MoveTime * 1e9 / NumCalls);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeOwnedArrayFreeTests, "MonoRuntime.Mono Owned Array Free Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMonoRuntimeOwnedArrayFreeTests::RunTest(const FString& Parameters)
+{
+	// arrays handed back to managed code by InvokeFunction are freed through UnrealArrayOwned_Free, elements which own memory must be destroyed
+	UArrayProperty* ArrayProperty = FindField<UArrayProperty>(UMonoTestsObject::StaticClass(), GET_MEMBER_NAME_CHECKED(UMonoTestsObject, TestStringStructArray));
+	check(ArrayProperty);
+
+	const int32 NumElements = 3;
+	FScriptArray ScriptArray;
+	{
+		FScriptArrayHelper Helper(ArrayProperty, &ScriptArray);
+		Helper.AddValues(NumElements);
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			reinterpret_cast<FMonoTestsStringStruct*>(Helper.GetRawPtr(Index))->TestString = FString::Printf(TEXT("Owned array element %d"), Index);
+		}
+	}
+
+	const int32 NumDestroyedBefore = FMonoTestsStringStruct::NumDestroyed;
+	UnrealArrayOwned_Free(ArrayProperty, &ScriptArray);
+
+	TestEqual(MONO_TEST_TEXT("Elements destroyed"), FMonoTestsStringStruct::NumDestroyed - NumDestroyedBefore, NumElements);
+	TestEqual(MONO_TEST_TEXT("Array is empty"), ScriptArray.Num(), 0);
+	TestEqual(MONO_TEST_TEXT("Array allocation is freed"), ScriptArray.GetSlack(), 0);
+
+	// UnrealArrayOwned only holds blittable elements, and frees them without the array property so it's safe from its finalizer
+	const int32 NumBlittableElements = 4;
+	FScriptArray BlittableArray;
+	BlittableArray.Add(NumBlittableElements, sizeof(FVector));
+	UnrealArrayOwned_Empty(&BlittableArray, sizeof(FVector));
+
+	TestEqual(MONO_TEST_TEXT("Blittable array is empty"), BlittableArray.Num(), 0);
+	TestEqual(MONO_TEST_TEXT("Blittable array allocation is freed"), BlittableArray.GetSlack(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimePropertyInfoLookupPerfTests, "MonoRuntime.Mono Property Info Lookup Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimePropertyInfoLookupPerfTests::RunTest(const FString& Parameters)
+{
+	static const int32 NumIterations = 100;
+
+	UClass* Class = AActor::StaticClass();
+	TArray<FString> PropertyNames;
+	for (TFieldIterator<UProperty> PropIt(Class, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+	{
+		PropertyNames.Add(PropIt->GetName());
+	}
+	const FString JoinedNames = FString::Join(PropertyNames, TEXT(";"));
+
+	// what generated static constructors used to do: several FindField walks per property
+	double PerNameTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(PerNameTime);
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			for (const FString& PropertyName : PropertyNames)
+			{
+				auto Name = StringCast<UTF16CHAR>(*PropertyName);
+				UnrealInterop_GetPropertyOffsetFromName(Class, Name.Get());
+				UnrealInterop_GetNativePropertyFromName(Class, Name.Get());
+			}
+		}
+	}
+
+	TArray<FMonoNativePropertyInfo> Infos;
+	Infos.AddZeroed(PropertyNames.Num());
+	double BulkTime = 0.0;
+	{
+		SCOPE_SECONDS_COUNTER(BulkTime);
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			UnrealInterop_GetNativePropertyInfos(Class, StringCast<UTF16CHAR>(*JoinedNames).Get(), PropertyNames.Num(), Infos.GetData());
+		}
+	}
+
+	for (int32 Index = 0; Index < PropertyNames.Num(); ++Index)
+	{
+		auto Name = StringCast<UTF16CHAR>(*PropertyNames[Index]);
+		TestEqual(MONO_TEST_TEXT("Bulk offset matches"), Infos[Index].Offset, UnrealInterop_GetPropertyOffsetFromName(Class, Name.Get()));
+		TestTrue(MONO_TEST_TEXT("Bulk property matches"), Infos[Index].Property == UnrealInterop_GetNativePropertyFromName(Class, Name.Get()));
+		TestEqual(MONO_TEST_TEXT("Bulk array dim matches"), Infos[Index].ArrayDim, UnrealInterop_GetPropertyArrayDimFromName(Class, Name.Get()));
+	}
+
+	UE_LOG(LogMono, Display, TEXT("%d lookups of %d %s properties: per-name %g us, bulk %g us"), NumIterations, PropertyNames.Num(), *Class->GetName(), PerNameTime * 1e6 / NumIterations, BulkTime * 1e6 / NumIterations);
+
+	return true;
+}
+
+// Compares the layout the generator bakes for each property of a struct or function against the dynamic lookup
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeBakedLayoutTests, "MonoRuntime.Mono Baked Layout Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMonoRuntimeBakedLayoutTests::RunTest(const FString& Parameters)
+{
+	// generated glue only assigns its baked offsets when UnrealInterop.ValidateBakedLayout accepts the hash baked with them,
+	// and looks the offsets up otherwise. MonoScriptGenerator's tests check the literals and the fallback in the glue itself.
+	const UPackage* Package = AActor::StaticClass()->GetOutermost();
+	const FString ModuleName = FPackageName::GetShortName(Package->GetName());
+	const uint32 LayoutHash = Mono::ComputeBakedLayoutHash(*Package);
+
+	TestTrue(MONO_TEST_TEXT("Baked layout with the running build's hash is used"), UnrealInterop_ValidateBakedLayout(StringCast<UTF16CHAR>(*ModuleName).Get(), LayoutHash));
+	TestFalse(MONO_TEST_TEXT("Baked layout with a mismatched hash falls back to the runtime lookup"), UnrealInterop_ValidateBakedLayout(StringCast<UTF16CHAR>(*ModuleName).Get(), LayoutHash ^ 1));
+	TestFalse(MONO_TEST_TEXT("Baked layout for a missing module falls back to the runtime lookup"), UnrealInterop_ValidateBakedLayout(StringCast<UTF16CHAR>(TEXT("MonoTestsMissingModule")).Get(), LayoutHash));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeScriptPackageClassIndexPerfTests, "MonoRuntime.Mono Script Package Class Index Perf Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeScriptPackageClassIndexPerfTests::RunTest(const FString& Parameters)
+{
+	TSet<FName> PackageNames;
+	double BuildTime = 0.0;
+	double IndexTime = 0.0;
+	double IteratorTime = 0.0;
+	int32 NumMismatchedPackages = 0;
+	{
+		TUniquePtr<FMonoScriptPackageClassIndex> Index;
+		{
+			SCOPE_SECONDS_COUNTER(BuildTime);
+			Index = MakeUnique<FMonoScriptPackageClassIndex>();
+		}
+		Index->GetPackageNames(PackageNames);
+
+		for (FName PackageName : PackageNames)
+		{
+			TArray<UClass*> IndexedClasses;
+			{
+				SCOPE_SECONDS_COUNTER(IndexTime);
+				Index->GetClassesInPackage(PackageName, IndexedClasses);
+			}
+
+			// what loading bindings for each script package used to do
+			TSet<UClass*> IteratedClasses;
+			{
+				SCOPE_SECONDS_COUNTER(IteratorTime);
+				for (TObjectIterator<UClass> ClassIt(RF_ClassDefaultObject, false); ClassIt; ++ClassIt)
+				{
+					if (ClassIt->GetOutermost()->GetFName() == PackageName)
+					{
+						IteratedClasses.Add(*ClassIt);
+					}
+				}
+			}
+
+			if (IteratedClasses.Num() != IndexedClasses.Num() || IteratedClasses.Difference(TSet<UClass*>(IndexedClasses)).Num() > 0)
+			{
+				++NumMismatchedPackages;
+				AddError(MONO_TEST_TEXT("Class index for %s differs from an object iterator pass", *PackageName.ToString()));
+			}
+		}
+	}
+
+	TestTrue(MONO_TEST_TEXT("Indexed some packages"), PackageNames.Num() > 0);
+	TestTrue(MONO_TEST_TEXT("Core classes are indexed"), PackageNames.Contains(UObject::StaticClass()->GetOutermost()->GetFName()));
+
+	UE_LOG(LogMono, Display, TEXT("Class lookups for %d packages (%d mismatched): build index %g ms, index %g ms, object iterator %g ms"),
+		PackageNames.Num(), NumMismatchedPackages, BuildTime * 1000.0, IndexTime * 1000.0, IteratorTime * 1000.0);
+
+	return true;
+}
+
+// Flattens assembly metadata to text so the json and binary loaders' results can be compared field by field
+static void AppendMetadataForComparison(FString& Out, const FMonoTypeReferenceMetadata& TypeRef)
+{
+	Out += FString::Printf(TEXT("[%s|%s|%s]"), *TypeRef.Namespace, *TypeRef.Name, *TypeRef.AssemblyName);
+}
+
+static void AppendMetadataForComparison(FString& Out, const FMonoPropertyMetadata& Property);
+
+static void AppendMetadataForComparison(FString& Out, const FMonoUnrealType& Type)
+{
+	Out += FString::Printf(TEXT("{%s %d "), *Type.UnrealPropertyClass.ToString(), Type.ArrayDim);
+
+	// same dispatch as FMonoUnrealType::ParseDerivedFromJsonObject
+	if (Type.UnrealPropertyClass == TEXT("EnumProperty"))
+	{
+		const FMonoUnrealEnumType& EnumType = static_cast<const FMonoUnrealEnumType&>(Type);
+		Out += EnumType.NativeClassOwner + TEXT(" ") + EnumType.NativeEnumName;
+		AppendMetadataForComparison(Out, EnumType.TypeRef);
+	}
+	else if (Type.UnrealPropertyClass == TEXT("CoreStructProperty"))
+	{
+		Out += static_cast<const FMonoCoreStructType&>(Type).StructName;
+	}
+	else if (Type.UnrealPropertyClass == UStructProperty::StaticClass()->GetFName())
+	{
+		const FMonoStructType& StructType = static_cast<const FMonoStructType&>(Type);
+		Out += StructType.NativeClassOwner;
+		AppendMetadataForComparison(Out, StructType.TypeRef);
+	}
+	else if (Type.UnrealPropertyClass == UObjectProperty::StaticClass()->GetFName())
+	{
+		AppendMetadataForComparison(Out, static_cast<const FMonoUnrealObjectType&>(Type).TypeRef);
+	}
+	else if (Type.UnrealPropertyClass == UClassProperty::StaticClass()->GetFName())
+	{
+		AppendMetadataForComparison(Out, static_cast<const FMonoUnrealClassType&>(Type).TypeRef);
+	}
+	else if (Type.UnrealPropertyClass == UWeakObjectProperty::StaticClass()->GetFName())
+	{
+		AppendMetadataForComparison(Out, static_cast<const FMonoUnrealWeakObjectType&>(Type).TypeRef);
+	}
+	else if (Type.UnrealPropertyClass == UArrayProperty::StaticClass()->GetFName())
+	{
+		AppendMetadataForComparison(Out, static_cast<const FMonoUnrealArrayType&>(Type).InnerProperty);
+	}
+	Out += TEXT("}");
+}
+
+static void AppendMetadataForComparison(FString& Out, const FMonoMetadataBase& Base)
+{
+	Out += FString::Printf(TEXT("%s %s %d"), *Base.Name.ToString(), *Base.NameCaseSensitive, (int32)Base.GetProtection());
+#if WITH_METADATA
+	for (const FMonoKeyValuePair& Pair : Base.Metadata)
+	{
+		Out += FString::Printf(TEXT(" %s=%s"), *Pair.Key.ToString(), *Pair.Value);
+	}
+#endif // WITH_METADATA
+}
+
+static void AppendMetadataForComparison(FString& Out, const FMonoPropertyMetadata& Property)
+{
+	// void functions leave their return value property unparsed
+	if (!Property.UnrealPropertyType.IsValid())
+	{
+		Out += TEXT("(none)");
+		return;
+	}
+
+	Out += TEXT("(");
+	AppendMetadataForComparison(Out, static_cast<const FMonoMetadataBase&>(Property));
+	AppendMetadataForComparison(Out, *Property.UnrealPropertyType);
+	Out += FString::Printf(TEXT(" %s %llu)"), *Property.RepNotifyFunctionName.ToString(), (uint64)Property.GetPropertyFlags());
+}
+
+static void AppendMetadataForComparison(FString& Out, const TArray<FMonoPropertyMetadata>& Properties)
+{
+	for (const FMonoPropertyMetadata& Property : Properties)
+	{
+		AppendMetadataForComparison(Out, Property);
+	}
+}
+
+static void AppendMetadataForComparison(FString& Out, const FMonoAssemblyMetadata& Metadata)
+{
+	Out += Metadata.AssemblyName + TEXT("\n") + Metadata.AssemblyPath + TEXT("\n");
+	for (const FMonoAssemblyReferenceMetadata& Reference : Metadata.References)
+	{
+		Out += FString::Printf(TEXT("reference %s %s %d %d\n"), *Reference.AssemblyName, *Reference.AssemblyPath, Reference.Resolved, Reference.InKnownLocation);
+	}
+	for (const FMonoStructMetadata& Struct : Metadata.Structs)
+	{
+		Out += TEXT("struct ");
+		AppendMetadataForComparison(Out, static_cast<const FMonoTypeReferenceMetadata&>(Struct));
+		AppendMetadataForComparison(Out, Struct.Properties);
+		Out += FString::Printf(TEXT(" %llu %s\n"), Struct.StructFlags, *Struct.StructHash);
+	}
+	for (const FMonoClassMetadata& Class : Metadata.Classes)
+	{
+		Out += TEXT("class ");
+		AppendMetadataForComparison(Out, static_cast<const FMonoTypeReferenceMetadata&>(Class));
+		Out += FString::Join(Class.VirtualFunctions, TEXT(","));
+		AppendMetadataForComparison(Out, Class.Properties);
+		for (const FMonoFunctionMetadata& Function : Class.Functions)
+		{
+			Out += TEXT(" function ");
+			AppendMetadataForComparison(Out, static_cast<const FMonoMetadataBase&>(Function));
+			AppendMetadataForComparison(Out, Function.ReturnValueProperty);
+			AppendMetadataForComparison(Out, Function.ParamProperties);
+			Out += FString::Printf(TEXT(" %u"), (uint32)Function.GetFunctionFlags());
+		}
+		AppendMetadataForComparison(Out, Class.BaseClass);
+		AppendMetadataForComparison(Out, Class.BaseUnrealNativeClass);
+		Out += FString::Printf(TEXT(" %d %d %s %s %s %s %d %d %s %s %s %llu\n"), Class.ChildCanTick, Class.OverridesBindInput, *Class.ClassHash, *Class.BlueprintUse,
+			*Class.Transience, *Class.Placeablity, Class.Abstract, Class.Deprecated, *Class.Group, *Class.ConfigFile, *Class.Flags, Class.ClassFlags);
+	}
+	for (const FMonoEnumMetadata& Enum : Metadata.Enums)
+	{
+		Out += TEXT("enum ");
+		AppendMetadataForComparison(Out, static_cast<const FMonoTypeReferenceMetadata&>(Enum));
+		Out += FString::Printf(TEXT(" %s %s %d\n"), *FString::Join(Enum.Items, TEXT(",")), *Enum.EnumHash, Enum.BlueprintVisible);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeAssemblyMetadataLoaderTests, "MonoRuntime.Mono Assembly Metadata Loader Tests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMonoRuntimeAssemblyMetadataLoaderTests::RunTest(const FString& Parameters)
+{
+	FMonoBindings& Bindings = FMonoBindings::Get();
+
+	int32 NumCompared = 0;
+	for (const FString& Directory : { Bindings.GetEngineAssemblyDirectory(), Bindings.GetGameAssemblyDirectory() })
+	{
+		TArray<FString> MetadataFiles;
+		IFileManager::Get().FindFiles(MetadataFiles, *FPaths::Combine(*Directory, TEXT("*.json")), true, false);
+
+		for (const FString& MetadataFileName : MetadataFiles)
+		{
+			const FString MetadataFile = FPaths::Combine(*Directory, *MetadataFileName);
+
+			FGuid BinaryGuid;
+			TSharedPtr<FMonoAssemblyMetadata> BinaryMetadata = FMonoLoadedAssemblyMetadata::LoadBinaryAssemblyMetadata(BinaryGuid, MetadataFile);
+			if (!BinaryMetadata.IsValid())
+			{
+				// no up to date binary next to this json, nothing to compare
+				continue;
+			}
+
+			FGuid JsonGuid;
+			TArray<FText> Errors;
+			TSharedPtr<FMonoAssemblyMetadata> JsonMetadata = FMonoLoadedAssemblyMetadata::LoadJsonAssemblyMetadata(JsonGuid, Errors, MetadataFile);
+			if (!JsonMetadata.IsValid())
+			{
+				AddError(MONO_TEST_TEXT("Could not load json metadata %s", *MetadataFileName));
+				continue;
+			}
+
+			FString BinaryText;
+			FString JsonText;
+			AppendMetadataForComparison(BinaryText, *BinaryMetadata);
+			AppendMetadataForComparison(JsonText, *JsonMetadata);
+
+			TestTrue(MONO_TEST_TEXT("Script package guid for %s", *MetadataFileName), BinaryGuid == JsonGuid);
+			TestEqual(MONO_TEST_TEXT("Binary and json metadata for %s", *MetadataFileName), BinaryText, JsonText);
+			++NumCompared;
+		}
+	}
+
+	TestTrue(MONO_TEST_TEXT("Found binary metadata to compare"), NumCompared > 0);
+
+	return true;
+}
+
+// Launches the project in a separate process with -MonoColdStartBenchmark and reads back its time to first tick
+static bool RunMonoColdStartProcess(bool bForceJIT, float& OutTimeToFirstTick, int32& OutNumAotImagesFound, FString& OutError)
+{
+	FString Params = FString::Printf(TEXT("\"%s\" -game -nullrhi -nosound -nosplash -unattended -stdout -MonoColdStartBenchmark"), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+	if (bForceJIT)
+	{
+		Params += TEXT(" -MonoForceJIT");
+	}
+
+	int32 ReturnCode = 0;
+	FString StdOut;
+	FString StdErr;
+	if (!FPlatformProcess::ExecProcess(FPlatformProcess::ExecutablePath(), *Params, &ReturnCode, &StdOut, &StdErr))
+	{
+		OutError = FString::Printf(TEXT("Could not launch '%s %s'"), FPlatformProcess::ExecutablePath(), *Params);
+		return false;
+	}
+
+	const int32 MarkerIndex = StdOut.Find(TEXT("MonoColdStart: "));
+	if (MarkerIndex == INDEX_NONE
+		|| !FParse::Value(*StdOut + MarkerIndex, TEXT("TimeToFirstTick="), OutTimeToFirstTick)
+		|| !FParse::Value(*StdOut + MarkerIndex, TEXT("AotImagesFound="), OutNumAotImagesFound))
+	{
+		OutError = FString::Printf(TEXT("No cold start timing in the output of '%s' (exit code %d)"), *Params, ReturnCode);
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoRuntimeColdStartPerfTests, "MonoRuntime.Mono Cold Start AOT Perf Tests", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FMonoRuntimeColdStartPerfTests::RunTest(const FString& Parameters)
+{
+	float WarmupTime = 0.0f;
+	float AotTime = 0.0f;
+	float JITTime = 0.0f;
+	int32 NumAotImagesFound = 0;
+	int32 NumJITAotImagesFound = 0;
+	FString Error;
+
+	// the first launch only warms the file cache, so neither measured run pays for cold disk reads the other doesn't
+	if (!RunMonoColdStartProcess(true, WarmupTime, NumJITAotImagesFound, Error)
+		|| !RunMonoColdStartProcess(false, AotTime, NumAotImagesFound, Error)
+		|| !RunMonoColdStartProcess(true, JITTime, NumJITAotImagesFound, Error))
+	{
+		AddError(Error);
+		return false;
+	}
+
+	TestEqual(MONO_TEST_TEXT("AOT images are ignored with -MonoForceJIT"), NumJITAotImagesFound, 0);
+	if (NumAotImagesFound == 0)
+	{
+		AddWarning(MONO_TEST_TEXT("No AOT images were found, build the managed assemblies with MonoUEAot=true to compare against JIT"));
+	}
+
+	UE_LOG(LogMono, Display, TEXT("Time to first tick: AOT %g s (AOT images found for %d assemblies), JIT %g s"), AotTime, NumAotImagesFound, JITTime);
+
+	return true;
+}
@@ -0,0 +1,11 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#include "Tests/MonoTestPooledObject.h"
+#include "MonoRuntimeCommon.h"
+
+UMonoTestPooledObject::UMonoTestPooledObject(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	TestReadableInt32 = 42;
+}
@@ -14,6 +14,8 @@
 
 #include "MonoLogBridge.h"
 
+int32 FMonoTestsStringStruct::NumDestroyed = 0;
+
 UMonoTestsObject::UMonoTestsObject(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectHash.h"
+#include "Misc/Crc.h"
+
+// Offsets and sizes MonoScriptGenerator bakes into generated glue, and the hash the runtime checks them against.
+// Header only because the generator runs inside UnrealHeaderTool and can't link MonoRuntime, and both sides must agree exactly.
+namespace Mono
+{
+	// What the generator bakes for a property, and what UnrealInterop_GetNativePropertyInfos looks up when the baked layout doesn't match
+	struct FBakedPropertyLayout
+	{
+		int32 Offset;
+		int32 ArrayDim;
+		// Inner element size for array properties, zero otherwise
+		int32 ArrayElementSize;
+	};
+
+	inline FBakedPropertyLayout GetBakedPropertyLayout(const UProperty& Property)
+	{
+		const UArrayProperty* ArrayProperty = Cast<UArrayProperty>(&Property);
+
+		FBakedPropertyLayout Layout;
+		Layout.Offset = Property.GetOffset_ForInternal();
+		Layout.ArrayDim = Property.ArrayDim;
+		Layout.ArrayElementSize = ArrayProperty ? ArrayProperty->Inner->GetSize() : 0;
+		return Layout;
+	}
+
+	// matches UnrealInterop_GetNativeStructSize
+	inline int32 GetBakedStructSize(const UScriptStruct& Struct)
+	{
+		return Struct.GetCppStructOps() ? Struct.GetCppStructOps()->GetSize() : Struct.GetStructureSize();
+	}
+
+	// Hash of the offsets and sizes of every struct, class and function in a /Script package, used to validate baked layouts.
+	inline uint32 ComputeBakedLayoutHash(const UPackage& Package)
+	{
+		// bump this when the hashed data changes so older baked layouts are rejected
+		const int32 BakedLayoutVersion = 1;
+		uint32 Hash = FCrc::MemCrc32(&BakedLayoutVersion, sizeof(BakedLayoutVersion));
+
+		auto HashInt = [&Hash](int32 Value)
+		{
+			Hash = FCrc::MemCrc32(&Value, sizeof(Value), Hash);
+		};
+		auto HashName = [&Hash](const UField& Field)
+		{
+			Hash = FCrc::StrCrc32(*Field.GetName(), Hash);
+		};
+		auto HashProperties = [&HashInt, &HashName](const UStruct& Struct)
+		{
+			for (TFieldIterator<UProperty> PropIt(&Struct, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+			{
+				const FBakedPropertyLayout Layout = GetBakedPropertyLayout(**PropIt);
+				HashName(**PropIt);
+				HashInt(Layout.Offset);
+				HashInt(Layout.ArrayDim);
+				HashInt(Layout.ArrayElementSize);
+			}
+		};
+
+		TArray<UObject*> PackageObjects;
+		GetObjectsWithOuter(&Package, PackageObjects, false);
+
+		TArray<UStruct*> Structs;
+		for (UObject* Object : PackageObjects)
+		{
+			UStruct* Struct = Cast<UStruct>(Object);
+			if (Struct && !Struct->IsA<UFunction>())
+			{
+				Structs.Add(Struct);
+			}
+		}
+		Structs.Sort([](const UStruct& A, const UStruct& B) { return A.GetName() < B.GetName(); });
+
+		for (const UStruct* Struct : Structs)
+		{
+			const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(Struct);
+			HashName(*Struct);
+			HashInt(Struct->GetPropertiesSize());
+			HashInt(ScriptStruct && ScriptStruct->GetCppStructOps() ? ScriptStruct->GetCppStructOps()->GetSize() : 0);
+			HashProperties(*Struct);
+
+			for (TFieldIterator<UFunction> FuncIt(Struct, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+			{
+				HashName(**FuncIt);
+				HashInt(FuncIt->ParmsSize);
+				HashProperties(**FuncIt);
+			}
+		}
+
+		return Hash;
+	}
+}
@@ -37,6 +37,14 @@ namespace UnrealBuildTool.Rules
                     "Json"
                 }
 			);
+
+			// only for the header-only MonoBakedLayout.h, UnrealHeaderTool plugins can't link runtime modules
+			PrivateIncludePathModuleNames.AddRange(
+				new string[]
+				{
+					"MonoRuntime",
+				}
+			);
 		}
 	}
 }
\ No newline at end of file
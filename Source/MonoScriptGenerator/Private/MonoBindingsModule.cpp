@@ -24,6 +24,7 @@ bool IsPluginModule(const FName ModuleName)
 FMonoBindingsModule::FMonoBindingsModule(FName InModuleName, const FString& RootMonoSourceDirectory, const FMonoGameModuleInfo* InGameInfo, FName InMappedModuleName)
 	: bExportModule(false)
 	, bExportExtensions(false)
+	, bExportBakedLayout(false)
 	, ModuleName(InModuleName)
 	, MappedModuleName(InMappedModuleName)
 {
@@ -5,6 +5,8 @@
 
 #include "CoreMinimal.h"
 
+class UStruct;
+
 struct FMonoGameModuleInfo
 {
 	FString GameModuleMonoIntermediateDirectory;
@@ -17,8 +19,11 @@ struct FMonoBindingsModule
 	TSet<FString> AdditionalSystemReferences;
 	TSet<FName> ModuleReferences;
 	TSet<FName> ExportedTypes;
+	// Classes and structs referenced by the exported types, including ones in other modules
+	TSet<UStruct*> TypeReferences;
 	bool bExportModule;
 	bool bExportExtensions;
+	bool bExportBakedLayout;
 
 	FMonoBindingsModule(FName InModuleName, const FString& RootMonoSourceDirectory, const FMonoGameModuleInfo* InGameInfo, FName InMappedModuleName);
 
@@ -4,14 +4,88 @@
 #include "MonoGeneratedFileManager.h"
 #include "MonoScriptGeneratorLog.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Hash/CityHash.h"
+#include "Dom/JsonValue.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+static uint64 HashGeneratedFileContents(const FString& Contents)
+{
+	return CityHash64(reinterpret_cast<const char*>(*Contents), Contents.Len() * sizeof(TCHAR));
+}
 
 FMonoGeneratedFileManager::~FMonoGeneratedFileManager()
 {
 	RenameTempFiles();
 }
 
+void FMonoGeneratedFileManager::LoadHashManifest(const FString& ManifestPath)
+{
+	FScopeLock Lock(&StateLock);
+
+	HashManifestPath = ManifestPath;
+	HashManifest.Empty();
+	GeneratedFiles.Empty();
+	bHashManifestDirty = false;
+
+	FString ManifestContents;
+	if (!FFileHelper::LoadFileToString(ManifestContents, *ManifestPath))
+	{
+		// first run, or the manifest was deleted; every file will be compared the slow way
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Manifest;
+	auto JsonReader = TJsonReaderFactory<>::Create(ManifestContents);
+	if (!FJsonSerializer::Deserialize(JsonReader, Manifest) || !Manifest.IsValid())
+	{
+		UE_LOG(LogMonoScriptGenerator, Warning, TEXT("Ignoring malformed generated file hash manifest: '%s'"), *ManifestPath);
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+	if (!Manifest->TryGetArrayField(TEXT("Files"), Files))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& FileValue : *Files)
+	{
+		const TSharedPtr<FJsonObject>* FileObject = nullptr;
+		if (!FileValue->TryGetObject(FileObject))
+		{
+			continue;
+		}
+
+		// 64 bit values are stored as strings, JSON numbers are doubles
+		FString Path, Hash, Size, Ticks;
+		if ((*FileObject)->TryGetStringField(TEXT("Path"), Path)
+			&& (*FileObject)->TryGetStringField(TEXT("Hash"), Hash)
+			&& (*FileObject)->TryGetStringField(TEXT("Size"), Size)
+			&& (*FileObject)->TryGetStringField(TEXT("Ticks"), Ticks))
+		{
+			FGeneratedFileRecord& Record = HashManifest.Add(Path);
+			Record.ContentHash = FCString::Strtoui64(*Hash, nullptr, 16);
+			Record.FileSize = FCString::Atoi64(*Size);
+			Record.ModificationTime = FDateTime(FCString::Atoi64(*Ticks));
+		}
+	}
+}
+
 void FMonoGeneratedFileManager::SaveFileIfChanged(const FString& FilePath, const FString& NewFileContents)
 {
+	const uint64 NewContentHash = HashGeneratedFileContents(NewFileContents);
+
+	{
+		FScopeLock Lock(&StateLock);
+		GeneratedFiles.Add(FilePath);
+		if (IsUnchangedOnDisk(FilePath, NewContentHash))
+		{
+			return;
+		}
+	}
+
 	FString OriginalFileLocal;
 	FFileHelper::LoadFileToString(OriginalFileLocal, *FilePath);
 
@@ -29,15 +103,25 @@ void FMonoGeneratedFileManager::SaveFileIfChanged(const FString& FilePath, const
 		}
 		else
 		{
+			FScopeLock Lock(&StateLock);
 			TempFiles.Add(TempFileName);
+			PendingHashes.Add(FilePath, NewContentHash);
 		}
 	}
+	else
+	{
+		// unchanged but not (or no longer) in the manifest, so next time it can be skipped without reading it
+		FScopeLock Lock(&StateLock);
+		RecordFile(FilePath, NewContentHash);
+	}
 }
 
 
 /** Renames/replaces all existing script glue files with the temporary (new) ones */
 void FMonoGeneratedFileManager::RenameTempFiles()
 {
+	FScopeLock Lock(&StateLock);
+
 	// Rename temp files
 	for (auto& TempFilename : TempFiles)
 	{
@@ -49,9 +133,120 @@ void FMonoGeneratedFileManager::RenameTempFiles()
 		else
 		{
 			UE_LOG(LogMonoScriptGenerator, Log, TEXT("Exported updated script glue: %s"), *Filename);
+
+			if (const uint64* ContentHash = PendingHashes.Find(Filename))
+			{
+				RecordFile(Filename, *ContentHash);
+			}
 		}
 	}
 
 	TempFiles.Empty();
+	PendingHashes.Empty();
+
+	SaveHashManifest();
+}
+
+void FMonoGeneratedFileManager::KeepFile(const FString& FilePath)
+{
+	FScopeLock Lock(&StateLock);
+	GeneratedFiles.Add(FilePath);
 }
 
+void FMonoGeneratedFileManager::PruneHashManifest()
+{
+	FScopeLock Lock(&StateLock);
+
+	for (auto It = HashManifest.CreateIterator(); It; ++It)
+	{
+		if (!GeneratedFiles.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+			bHashManifestDirty = true;
+		}
+	}
+
+	GeneratedFiles.Empty();
+
+	SaveHashManifest();
+}
+
+bool FMonoGeneratedFileManager::IsUnchangedOnDisk(const FString& FilePath, uint64 ContentHash) const
+{
+	if (HashManifestPath.IsEmpty())
+	{
+		return false;
+	}
+
+	const FGeneratedFileRecord* Record = HashManifest.Find(FilePath);
+	if (Record == nullptr || Record->ContentHash != ContentHash)
+	{
+		return false;
+	}
+
+	// a matching stat means nobody touched the file since we recorded its hash
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+	return StatData.bIsValid
+		&& StatData.FileSize == Record->FileSize
+		&& StatData.ModificationTime == Record->ModificationTime;
+}
+
+void FMonoGeneratedFileManager::RecordFile(const FString& FilePath, uint64 ContentHash)
+{
+	if (HashManifestPath.IsEmpty())
+	{
+		return;
+	}
+
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+	if (!StatData.bIsValid)
+	{
+		return;
+	}
+
+	FGeneratedFileRecord& Record = HashManifest.FindOrAdd(FilePath);
+	Record.ContentHash = ContentHash;
+	Record.FileSize = StatData.FileSize;
+	Record.ModificationTime = StatData.ModificationTime;
+	bHashManifestDirty = true;
+}
+
+void FMonoGeneratedFileManager::SaveHashManifest()
+{
+	if (HashManifestPath.IsEmpty() || !bHashManifestDirty)
+	{
+		return;
+	}
+
+	TArray<FString> Paths;
+	HashManifest.GetKeys(Paths);
+	// keep the manifest stable between runs
+	Paths.Sort();
+
+	TArray<TSharedPtr<FJsonValue>> Files;
+	for (const FString& Path : Paths)
+	{
+		const FGeneratedFileRecord& Record = HashManifest[Path];
+
+		TSharedPtr<FJsonObject> FileObject = MakeShareable(new FJsonObject);
+		FileObject->SetStringField(TEXT("Path"), Path);
+		FileObject->SetStringField(TEXT("Hash"), FString::Printf(TEXT("%016llx"), Record.ContentHash));
+		FileObject->SetStringField(TEXT("Size"), FString::Printf(TEXT("%lld"), Record.FileSize));
+		FileObject->SetStringField(TEXT("Ticks"), FString::Printf(TEXT("%lld"), Record.ModificationTime.GetTicks()));
+		Files.Add(MakeShareable(new FJsonValueObject(FileObject)));
+	}
+
+	TSharedPtr<FJsonObject> Manifest = MakeShareable(new FJsonObject);
+	Manifest->SetArrayField(TEXT("Files"), Files);
+
+	FString OutputString;
+	auto JsonWriter = TJsonWriterFactory<>::Create(&OutputString);
+	verify(FJsonSerializer::Serialize(Manifest.ToSharedRef(), JsonWriter));
+
+	if (!FFileHelper::SaveStringToFile(OutputString, *HashManifestPath))
+	{
+		UE_LOG(LogMonoScriptGenerator, Warning, TEXT("Failed to save generated file hash manifest: '%s'"), *HashManifestPath);
+	}
+
+	bHashManifestDirty = false;
+}
@@ -4,19 +4,59 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 
 class FMonoGeneratedFileManager
 {
 public:
 	~FMonoGeneratedFileManager();
 
-	/** Saves generated script glue to a temporary file if its contents is different from the existing one. */
+	/**
+	 * Loads the sidecar manifest of content hashes for previously generated files.
+	 * When set, files whose size, timestamp and content hash match the manifest are skipped without being read back.
+	 * The manifest is written out by RenameTempFiles.
+	 */
+	void LoadHashManifest(const FString& ManifestPath);
+
+	/** Saves generated script glue to a temporary file if its contents is different from the existing one. Safe to call from multiple threads. */
 	void SaveFileIfChanged(const FString& FilePath, const FString& NewFileContents);
 	/** Renames/replaces all existing script glue files with the temporary (new) ones */
 	void RenameTempFiles();
 
+	/** Marks a file that is still generated, but was skipped without being saved this run, so PruneHashManifest keeps its hash. */
+	void KeepFile(const FString& FilePath);
+	/** Drops manifest entries for files that were neither saved nor kept since the last prune, i.e. are no longer generated, and saves the manifest. */
+	void PruneHashManifest();
+
 private:
+	friend class FMonoScriptGeneratorFileManagerTests;
+
+	struct FGeneratedFileRecord
+	{
+		uint64 ContentHash;
+		int64 FileSize;
+		FDateTime ModificationTime;
+	};
+
+	/** Returns true if FilePath is on disk as it was last recorded, with the same content hash. Caller must hold StateLock. */
+	bool IsUnchangedOnDisk(const FString& FilePath, uint64 ContentHash) const;
+	/** Records the current size and timestamp of FilePath along with its content hash. Caller must hold StateLock. */
+	void RecordFile(const FString& FilePath, uint64 ContentHash);
+	void SaveHashManifest();
+
 	/** List of temporary files crated by SaveFileIfChanged */
 	TArray<FString> TempFiles;
+	/** Content hashes of the temporary files, keyed by the final file name, recorded once they are renamed */
+	TMap<FString, uint64> PendingHashes;
+
+	/** Empty if no hash manifest is used */
+	FString HashManifestPath;
+	TMap<FString, FGeneratedFileRecord> HashManifest;
+	/** Files saved or kept since the last prune */
+	TSet<FString> GeneratedFiles;
+	bool bHashManifestDirty = false;
+
+	/** Guards the temp file list and the hash manifest */
+	FCriticalSection StateLock;
 
-};
\ No newline at end of file
+};
@@ -4,6 +4,7 @@
 #include "MonoPropertyHandler.h"
 #include "MonoScriptCodeGenerator.h"
 #include "MonoScriptCodeGeneratorUtils.h"
+#include "MonoBakedLayout.h"
 #include "UObject/UObjectIterator.h"
 #include "UObject/TextProperty.h"
 #include "UObject/EnumProperty.h"
@@ -152,27 +153,45 @@ void FMonoPropertyHandler::ExportMirrorProperty(FMonoTextBuilder& Builder, const
 	Builder.AppendLine();
 }
 
-void FMonoPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
+void FMonoPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const
 {
-	Builder.AppendLine(FString::Printf(TEXT("%s_Offset = UnrealInterop.GetPropertyOffsetFromName(NativeClassPtr, \"%s\");"),
-		*NativePropertyName,
-		*NativePropertyName));
+	if (bBakedLayout)
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_Offset = %d;"), *NativePropertyName, Mono::GetBakedPropertyLayout(*Property).Offset));
+	}
+	else
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_Offset = %s.Offset;"), *NativePropertyName, *PropertyInfo));
+	}
 
 	if (Property->ArrayDim > 1)
 	{
 		check(IsSupportedInStaticArray());
-		Builder.AppendLine(FString::Printf(TEXT("%s_Length = UnrealInterop.GetPropertyArrayDimFromName(NativeClassPtr, \"%s\");"), *NativePropertyName, *NativePropertyName));
+		if (bBakedLayout)
+		{
+			Builder.AppendLine(FString::Printf(TEXT("%s_Length = %d;"), *NativePropertyName, Mono::GetBakedPropertyLayout(*Property).ArrayDim));
+		}
+		else
+		{
+			Builder.AppendLine(FString::Printf(TEXT("%s_Length = %s.ArrayDim;"), *NativePropertyName, *PropertyInfo));
+		}
 	}
 }
 
-void FMonoPropertyHandler::ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter) const
+void FMonoPropertyHandler::ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter, const FString& ParamInfo, bool bBakedLayout) const
 {
 	const FString ParamName = Parameter->GetName();
-	Builder.AppendLine(FString::Printf(TEXT("%s_%s_Offset = UnrealInterop.GetPropertyOffsetFromName(%s_NativeFunction, \"%s\");"),
-		*NativeMethodName,
-		*ParamName,
-		*NativeMethodName,
-		*ParamName));
+	if (bBakedLayout)
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_Offset = %d;"), *NativeMethodName, *ParamName, Mono::GetBakedPropertyLayout(*Parameter).Offset));
+	}
+	else
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_Offset = %s.Offset;"),
+			*NativeMethodName,
+			*ParamName,
+			*ParamInfo));
+	}
 }
 
 FMonoPropertyHandler::FunctionExporter::FunctionExporter(const FMonoPropertyHandler& InHandler, UFunction& InFunction, ProtectionMode InProtectionMode, OverloadMode InOverloadMode, BlueprintVisibility InBlueprintVisibility)
@@ -993,6 +1012,27 @@ FString FBlittableTypePropertyHandler::GetMarshalerType(const UProperty *Propert
 	return FString::Printf(TEXT("BlittableTypeMarshaler<%s>"), *GetCSharpType(Property));
 }
 
+void FBlittableTypePropertyHandler::ExportMarshalToNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& NativePropertyName, const FString& DestinationBuffer, const FString& Offset, const FString& Source) const
+{
+	Builder.AppendUnsafeLine(FString::Printf(TEXT("*(%s*)IntPtr.Add(%s, %s).ToPointer() = %s;"), *GetCSharpType(Property), *DestinationBuffer, *Offset, *Source));
+}
+
+void FBlittableTypePropertyHandler::ExportMarshalFromNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& NativePropertyName, const FString& AssignmentOrReturn, const FString& SourceBuffer, const FString& Offset, bool bCleanupSourceBuffer, bool reuseRefMarshallers) const
+{
+	// Declarations can't be scoped inside an unsafe { } line, so they're only expected inside unsafe blocks (e.g. Invoke_ methods).
+	Builder.AppendUnsafeLine(FString::Printf(TEXT("%s *(%s*)IntPtr.Add(%s, %s).ToPointer();"), *AssignmentOrReturn, *GetCSharpType(Property), *SourceBuffer, *Offset));
+}
+
+FString FBlittableTypePropertyHandler::ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const
+{
+	// Non-capturing lambdas are cached by the compiler, so these don't allocate per use the way method group conversions do.
+	const FString CSharpType = GetCSharpType(Property);
+	return FString::Printf(
+		TEXT("(IntPtr __buffer, int __index, UnrealObject __owner, %s __value) => { unsafe { ((%s*)__buffer.ToPointer())[__index] = __value; } }, ")
+		TEXT("(IntPtr __buffer, int __index, UnrealObject __owner) => { unsafe { return ((%s*)__buffer.ToPointer())[__index]; } }"),
+		*CSharpType, *CSharpType, *CSharpType);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 // FFloatPropertyHandler
@@ -1047,6 +1087,21 @@ FString FEnumPropertyHandler::GetMarshalerType(const UProperty *Property) const
 	return FString::Printf(TEXT("EnumMarshaler<%s>"), *GetCSharpType(Property));
 }
 
+void FEnumPropertyHandler::ExportMarshalToNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& NativePropertyName, const FString& DestinationBuffer, const FString& Offset, const FString& Source) const
+{
+	FSimpleTypePropertyHandler::ExportMarshalToNativeBuffer(Builder, Property, Owner, NativePropertyName, DestinationBuffer, Offset, Source);
+}
+
+void FEnumPropertyHandler::ExportMarshalFromNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& NativePropertyName, const FString& AssignmentOrReturn, const FString& SourceBuffer, const FString& Offset, bool bCleanupSourceBuffer, bool reuseRefMarshallers) const
+{
+	FSimpleTypePropertyHandler::ExportMarshalFromNativeBuffer(Builder, Property, Owner, NativePropertyName, AssignmentOrReturn, SourceBuffer, Offset, bCleanupSourceBuffer, reuseRefMarshallers);
+}
+
+FString FEnumPropertyHandler::ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const
+{
+	return FSimpleTypePropertyHandler::ExportMarshalerDelegates(Property, PropertyName);
+}
+
 FString FEnumPropertyHandler::ConvertCppDefaultParameterToCSharp(const FString& CppDefaultValue, UFunction* Function, UProperty* ParamProperty) const
 {
 	// Default value may be namespaced in C++, and must be in C#.
@@ -1100,10 +1155,10 @@ FString FTextPropertyHandler::GetCSharpType(const UProperty* Property) const
 	return TEXT("Text");
 }
 
-void FTextPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
+void FTextPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const
 {
-	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName);
-	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = UnrealInterop.GetNativePropertyFromName(NativeClassPtr, \"%s\");"), *NativePropertyName, *NativePropertyName));
+	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName, PropertyInfo, bBakedLayout);
+	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = %s.Property;"), *NativePropertyName, *PropertyInfo));
 }
 
 void FTextPropertyHandler::ExportPropertyVariables(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
@@ -1181,10 +1236,10 @@ FString FWeakObjectPropertyHandler::GetMarshalerType(const UProperty *Property)
 // FBitfieldPropertyHandler
 //////////////////////////////////////////////////////////////////////////
 
-void FBitfieldPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
+void FBitfieldPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const
 {
-	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName);
-	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = UnrealInterop.GetNativePropertyFromName(NativeClassPtr, \"%s\");"), *NativePropertyName, *NativePropertyName));
+	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName, PropertyInfo, bBakedLayout);
+	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = %s.Property;"), *NativePropertyName, *PropertyInfo));
 }
 
 bool FBitfieldPropertyHandler::CanHandleProperty(const UProperty* Property) const
@@ -1239,10 +1294,10 @@ FString FStringPropertyHandler::GetCSharpType(const UProperty* Property) const
 	return TEXT("string");
 }
 
-void FStringPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
+void FStringPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const
 {
-	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName);
-	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = UnrealInterop.GetNativePropertyFromName(NativeClassPtr, \"%s\");"), *NativePropertyName, *NativePropertyName));
+	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName, PropertyInfo, bBakedLayout);
+	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = %s.Property;"), *NativePropertyName, *PropertyInfo));
 }
 
 void FStringPropertyHandler::ExportPropertyVariables(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
@@ -1294,6 +1349,12 @@ void FStringPropertyHandler::ExportMarshalFromNativeBuffer(FMonoTextBuilder& Bui
 	{
 		Builder.AppendLine(FString::Printf(TEXT("IntPtr %s_NativePtr = IntPtr.Add(%s,%s);"), *NativePropertyName, *SourceBuffer, *Offset));
 	}
+	if (bCleanupSourceBuffer && !reuseRefMarshallers)
+	{
+		// Out params and return values are left as live FStrings by InvokeFunction, so move them straight into a managed string.
+		Builder.AppendLine(FString::Printf(TEXT("%s StringMarshalerWithCleanup.MoveFromNative(%s_NativePtr,0);"), *AssignmentOrReturn, *NativePropertyName));
+		return;
+	}
 	// The mirror struct references a temp string buffer which we must clean up.
 	Builder.AppendLine(FString::Printf(TEXT("%s StringMarshalerWithCleanup.FromNative(%s_NativePtr,0,%s);"),*AssignmentOrReturn, *NativePropertyName, *Owner));
 	if (bCleanupSourceBuffer)
@@ -1406,17 +1467,28 @@ FString FArrayPropertyHandler::GetCSharpType(const UProperty* Property) const
 	return GetWrapperInterface(Property);
 }
 
-void FArrayPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
+void FArrayPropertyHandler::ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const
 {
-	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName);
-	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = UnrealInterop.GetNativePropertyFromName(NativeClassPtr, \"%s\");"), *NativePropertyName, *NativePropertyName));
+	FMonoPropertyHandler::ExportPropertyStaticConstruction(Builder, Property, NativePropertyName, PropertyInfo, bBakedLayout);
+	Builder.AppendLine(FString::Printf(TEXT("%s_NativeProperty = %s.Property;"), *NativePropertyName, *PropertyInfo));
 }
 
-void FArrayPropertyHandler::ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter) const
+void FArrayPropertyHandler::ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter, const FString& ParamInfo, bool bBakedLayout) const
 {
-	FMonoPropertyHandler::ExportParameterStaticConstruction(Builder, NativeMethodName, Parameter);
+	FMonoPropertyHandler::ExportParameterStaticConstruction(Builder, NativeMethodName, Parameter, ParamInfo, bBakedLayout);
 	const FString ParamName = Parameter->GetName();
-	Builder.AppendLine(FString::Printf(TEXT("%s_%s_ElementSize = UnrealInterop.GetArrayElementSize(%s_NativeFunction, \"%s\");"), *NativeMethodName, *ParamName, *NativeMethodName, *ParamName));
+	if (bBakedLayout)
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_ElementSize = %d;"), *NativeMethodName, *ParamName, Mono::GetBakedPropertyLayout(*Parameter).ArrayElementSize));
+		// the property is needed to destroy the elements of arrays handed back by native code, which the baked layout can't provide
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_NativeProperty = UnrealInterop.GetNativePropertyFromName(GetNativeFunctionFromClassAndName(NativeClassPtr, \"%s\"), \"%s\");"),
+			*NativeMethodName, *ParamName, *Parameter->GetOuter()->GetName(), *ParamName));
+	}
+	else
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_ElementSize = %s.ArrayElementSize;"), *NativeMethodName, *ParamName, *ParamInfo));
+		Builder.AppendLine(FString::Printf(TEXT("%s_%s_NativeProperty = %s.Property;"), *NativeMethodName, *ParamName, *ParamInfo));
+	}
 }
 
 void FArrayPropertyHandler::ExportPropertyVariables(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
@@ -1430,6 +1502,7 @@ void FArrayPropertyHandler::ExportParameterVariables(FMonoTextBuilder& Builder,
 {
 	FMonoPropertyHandler::ExportParameterVariables(Builder, Function, NativeMethodName, ParamProperty, NativePropertyName);
 	Builder.AppendLine(FString::Printf(TEXT("static readonly int %s_%s_ElementSize;"), *NativeMethodName, *NativePropertyName));
+	Builder.AppendLine(FString::Printf(TEXT("static readonly IntPtr %s_%s_NativeProperty;"), *NativeMethodName, *NativePropertyName));
 }
 
 void FArrayPropertyHandler::ExportPropertyGetter(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const
@@ -1488,16 +1561,29 @@ void FArrayPropertyHandler::ExportMarshalFromNativeBuffer(FMonoTextBuilder& Buil
 	FString InnerType = Handler.GetCSharpType(InnerProperty);
 	FString MarshalerType = FString::Printf(TEXT("UnrealArrayCopyMarshaler<%s>"), *InnerType);
 
+	FString ElementSize = NativePropertyName + TEXT("_ElementSize");
+	FString NativeProperty = NativePropertyName + TEXT("_NativeProperty");
+	if (UFunction* Function = Cast<UFunction>(Property->GetOuter()))
+	{
+		FString NativeFunctionName = Function->GetName();
+		ElementSize = NativeFunctionName + TEXT("_") + ElementSize;
+		NativeProperty = NativeFunctionName + TEXT("_") + NativeProperty;
+	}
+
+	// Out params and return values are left as live TArrays by InvokeFunction.
+	const bool bNativeOwnedSource = bCleanupSourceBuffer && !reuseRefMarshallers;
+	if (bNativeOwnedSource && Handler.IsBlittable())
+	{
+		// Blittable elements can be used in place, so take over the allocation instead of copying it.
+		// UnrealArrayOwned frees it without the array property, which is only safe because the elements are blittable.
+		Builder.AppendLine(FString::Printf(TEXT("IntPtr %s_NativeBuffer = IntPtr.Add(%s, %s);"), *NativePropertyName, *SourceBuffer, *Offset));
+		Builder.AppendLine(FString::Printf(TEXT("%s UnrealArrayOwned<%s>.FromNative(%s_NativeBuffer, 0, %s, %s);"), *AssignmentOrReturn, *InnerType, *NativePropertyName, *Handler.ExportMarshalerDelegates(InnerProperty, NativePropertyName), *ElementSize));
+		return;
+	}
+
 	//if it was a "ref" parameter, we set the marshaler up before calling the function. if not, create one.
 	if (!reuseRefMarshallers)
 	{
-		FString ElementSize = NativePropertyName + TEXT("_ElementSize");
-		if (UFunction* Function = Cast<UFunction>(Property->GetOuter()))
-		{
-			FString NativeFunctionName = Function->GetName();
-			ElementSize = NativeFunctionName + TEXT("_") + ElementSize;
-		}
-
 		//Native buffer variable used in cleanup
 		Builder.AppendLine(FString::Printf(TEXT("IntPtr %s_NativeBuffer = IntPtr.Add(%s, %s);"), *NativePropertyName, *SourceBuffer, *Offset));
 		Builder.AppendLine(FString::Printf(TEXT("%s %s_Marshaler = new %s (1, %s, %s);"), *MarshalerType, *NativePropertyName, *MarshalerType, *Handler.ExportMarshalerDelegates(InnerProperty, NativePropertyName), *ElementSize));
@@ -1509,7 +1595,14 @@ void FArrayPropertyHandler::ExportMarshalFromNativeBuffer(FMonoTextBuilder& Buil
 		// Ensure we're not generating unreachable cleanup code.
 		check(AssignmentOrReturn != TEXT("return"));
 
-		Builder.AppendLine(FString::Printf(TEXT("%s.DestructInstance(%s_NativeBuffer, 0);"), *MarshalerType, *NativePropertyName));
+		if (bNativeOwnedSource)
+		{
+			Builder.AppendLine(FString::Printf(TEXT("%s.DestructNativeInstance(%s_NativeBuffer, 0, %s);"), *MarshalerType, *NativePropertyName, *NativeProperty));
+		}
+		else
+		{
+			Builder.AppendLine(FString::Printf(TEXT("%s.DestructInstance(%s_NativeBuffer, 0);"), *MarshalerType, *NativePropertyName));
+		}
 	}
 }
 
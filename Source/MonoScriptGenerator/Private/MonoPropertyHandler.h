@@ -98,8 +98,12 @@ public:
 
 	// Exports a C# property which wraps a native UProperty, suitable for use in a reference type backed by a UObject.
 	void ExportWrapperProperty(FMonoTextBuilder& Builder, const UProperty* Property, bool IsGreylisted, bool IsWhitelisted) const;
-	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const;
-	virtual void ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter) const;
+	// PropertyInfo/ParamInfo is a C# expression for the UnrealInterop.NativePropertyInfo fetched in bulk by the static constructor.
+	// With bBakedLayout, offsets and sizes are emitted as literals from the generating process, and PropertyInfo is only
+	// provided for properties which return true from NeedsNativePropertyInStaticConstruction.
+	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const;
+	virtual void ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& NativeMethodName, const UProperty* Parameter, const FString& ParamInfo, bool bBakedLayout) const;
+	virtual bool NeedsNativePropertyInStaticConstruction() const { return false; }
 	// helpers for collapsed getter/setters
 	void BeginWrapperPropertyAccessorBlock(FMonoTextBuilder& Builder, const UProperty* Property, const FString& PropertyName, const UField* DocCommentField) const;
 	void EndWrapperPropertyAccessorBlock(FMonoTextBuilder& Builder, const UProperty* Property) const;
@@ -303,9 +307,15 @@ public:
 	}
 
 	virtual bool IsBlittable() const override { return true; }
+
+	// Blittable values are read and written through typed pointers rather than going through the marshaler.
+	virtual FString ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const override;
 protected:
 
 	virtual FString GetMarshalerType(const UProperty *Property) const override;
+
+	virtual void ExportMarshalToNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& PropertyName, const FString& DestinationBuffer, const FString& Offset, const FString& Source) const override;
+	virtual void ExportMarshalFromNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& PropertyName, const FString& AssignmentOrReturn, const FString& SourceBuffer, const FString& Offset, bool bCleanupSourceBuffer, bool reuseRefMarshallers) const override;
 };
 
 class FFloatPropertyHandler : public FBlittableTypePropertyHandler
@@ -333,6 +343,9 @@ public:
 	virtual FString GetCSharpType(const UProperty* Property) const override;
 	virtual FString ConvertCppDefaultParameterToCSharp(const FString& CppDefaultValue, UFunction* Function, UProperty* ParamProperty) const override;
 
+	// The C# enum's underlying type doesn't always match the property size, so enums keep using EnumMarshaler.
+	virtual FString ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const override;
+
 	static void AddStrippedPrefix(const UEnum* Enum, const FString& Prefix)
 	{
 		check(!StrippedPrefixes.Contains(Enum->GetFName()));
@@ -340,6 +353,9 @@ public:
 	}
 protected:
 	virtual FString GetMarshalerType(const UProperty *Property) const override;
+
+	virtual void ExportMarshalToNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& PropertyName, const FString& DestinationBuffer, const FString& Offset, const FString& Source) const override;
+	virtual void ExportMarshalFromNativeBuffer(FMonoTextBuilder& Builder, const UProperty* Property, const FString &Owner, const FString& PropertyName, const FString& AssignmentOrReturn, const FString& SourceBuffer, const FString& Offset, bool bCleanupSourceBuffer, bool reuseRefMarshallers) const override;
 private:
 	static TMap<FName, FString> StrippedPrefixes;
 };
@@ -367,7 +383,8 @@ public:
 	virtual bool CanHandleProperty(const UProperty* Property) const override;
 	virtual FString GetCSharpType(const UProperty* Property) const override;
 
-	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const override;
+	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const override;
+	virtual bool NeedsNativePropertyInStaticConstruction() const override { return true; }
 	
 	virtual FString ExportInstanceMarshalerVariables(const UProperty *Property, const FString &PropertyName) const;
 	virtual FString ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const;
@@ -414,7 +431,8 @@ public:
 	virtual bool CanHandleProperty(const UProperty* Property) const override;
 	virtual FString GetCSharpType(const UProperty* Property) const override;
 
-	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const override;
+	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const override;
+	virtual bool NeedsNativePropertyInStaticConstruction() const override { return true; }
 
 protected:
 	virtual void ExportPropertyVariables(FMonoTextBuilder& Builder, const UProperty* Property, const FString& PropertyName) const override;
@@ -449,7 +467,8 @@ public:
 
 	virtual bool CanHandleProperty(const UProperty* Property) const override;
 	virtual FString GetCSharpType(const UProperty* Property) const override;
-	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const override;
+	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const override;
+	virtual bool NeedsNativePropertyInStaticConstruction() const override { return true; }
 	virtual FString ConvertCppDefaultParameterToCSharp(const FString& CppDefaultValue, UFunction* Function, UProperty* ParamProperty) const override;
 
 	virtual FString ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const;
@@ -513,8 +532,9 @@ public:
 	virtual void AddReferences(const UProperty* Property, TSet<UStruct*>& References) const override;
 
 	virtual FString GetCSharpType(const UProperty* Property) const override;
-	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName) const override;
-	virtual void ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& CSharpMethodName, const UProperty* Parameter) const override;
+	virtual void ExportPropertyStaticConstruction(FMonoTextBuilder& Builder, const UProperty* Property, const FString& NativePropertyName, const FString& PropertyInfo, bool bBakedLayout) const override;
+	virtual bool NeedsNativePropertyInStaticConstruction() const override { return true; }
+	virtual void ExportParameterStaticConstruction(FMonoTextBuilder& Builder, const FString& CSharpMethodName, const UProperty* Parameter, const FString& ParamInfo, bool bBakedLayout) const override;
 
 	virtual FString ExportInstanceMarshalerVariables(const UProperty *Property, const FString &PropertyName) const override;
 	virtual FString ExportMarshalerDelegates(const UProperty *Property, const FString &PropertyName) const override;
@@ -5,6 +5,7 @@
 #include "MonoPropertyHandler.h"
 #include "MonoScriptCodeGeneratorUtils.h"
 #include "MonoScriptGeneratorLog.h"
+#include "MonoBakedLayout.h"
 
 #include "UObject/Stack.h"
 #include "UObject/UObjectIterator.h"
@@ -12,10 +13,21 @@
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
 #include "Templates/Casts.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CommandLine.h"
+#include "Modules/ModuleManager.h"
+#include "Dom/JsonValue.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
 
 FMonoScriptCodeGenerator::FMonoScriptCodeGenerator()
-	: bModuleRegistrationOpen(false), NameMapper(this)
+	: bModuleRegistrationOpen(false), bBakeNativeLayout(false), NameMapper(this)
 {
+	// -MonoSerialGlue forces glue to be generated on one thread, for debugging the generator
+	bParallelGlueGeneration = !FParse::Param(FCommandLine::Get(), TEXT("MonoSerialGlue"));
+	// -MonoIncrementalGlue skips regenerating modules whose inputs haven't changed since the last export
+	bIncrementalGlueGeneration = FParse::Param(FCommandLine::Get(), TEXT("MonoIncrementalGlue"));
 }
 
 void FMonoScriptCodeGenerator::Initialize(const FString& RootLocalPath, const FString& RootBuildPath, const FString& OutputDirectory)
@@ -40,6 +52,12 @@ void FMonoScriptCodeGenerator::Initialize(const FString& RootLocalPath, const FS
 		UE_LOG(LogMonoScriptGenerator, Error, TEXT("Could not create directory %s"), *MonoOutputDirectory);
 	}
 
+	// lets unchanged glue be skipped on the next run without reading it back
+	GeneratedFileManager.LoadHashManifest(FPaths::Combine(*MonoOutputDirectory, TEXT("GeneratedFileHashes.json")));
+
+	GlueModuleStatePath = FPaths::Combine(*MonoOutputDirectory, TEXT("GlueModuleState.json"));
+	LoadGlueModuleStates();
+
 	EngineRoot = RootLocalPath;
 
 	MonoUEPluginDirectory = FPaths::Combine(*RootLocalPath, TEXT("Engine"), TEXT("Plugins"), TEXT("MonoUE"));
@@ -187,6 +205,11 @@ void FMonoScriptCodeGenerator::Initialize(const FString& RootLocalPath, const FS
 
 void FMonoScriptCodeGenerator::GatherClassForExport(UClass* Class, const FString& SourceHeaderFilename, const FString& GeneratedHeaderFilename, bool bHasChanged)
 {
+	if (bHasChanged)
+	{
+		ModulesChangedByUHT.Add(MonoScriptCodeGeneratorUtils::GetModuleFName(*Class));
+	}
+
 	if (CanExportClass(Class) && !TopLevelExportedClasses.Contains(Class))
 	{
 		TArray<UProperty*> ExportedProperties;
@@ -222,6 +245,8 @@ void FMonoScriptCodeGenerator::FinishExport(const TSet<FName>& ModulesToExport,
 
 	ExportClasses();
 
+	ExportBakedLayouts();
+
 	ExportExtensionMethods();
 
 	// update cs files
@@ -233,6 +258,13 @@ void FMonoScriptCodeGenerator::FinishExport(const TSet<FName>& ModulesToExport,
 	// Commit csprojs
 	GeneratedFileManager.RenameTempFiles();
 
+	// Forget the hashes of files this export no longer generates
+	GeneratedFileManager.PruneHashManifest();
+
+	// Only now is everything on disk, so the next incremental export can trust it
+	SaveGlueModuleStates();
+	ModulesChangedByUHT.Empty();
+
 	// Dump a report of unhandled UProperties by type and usage.
 	LogUnhandledProperties();
 }
@@ -253,6 +285,139 @@ FString FMonoScriptCodeGenerator::GetQualifiedSuperClassName(const UClass* Class
 }
 
 void FMonoScriptCodeGenerator::ExportClasses()
+{
+	TArray<const UStruct*> TypesToExport;
+	GatherTypesToExport(TypesToExport);
+
+	// hashed on full exports too, so they leave state behind for the next incremental one
+	ComputeModuleInputHashes(TypesToExport);
+
+	UpToDateModules.Empty();
+	if (bIncrementalGlueGeneration)
+	{
+		GatherUpToDateModules(UpToDateModules);
+
+		TypesToExport.RemoveAll([this](const UStruct* Struct)
+		{
+			return UpToDateModules.Contains(MonoScriptCodeGeneratorUtils::GetModuleFName(*Struct));
+		});
+
+		UE_LOG(LogMonoScriptGenerator, Display, TEXT("Incremental glue generation: %d of %d modules are up to date, exporting %d types"),
+			UpToDateModules.Num(), ModuleInputHashes.Num(), TypesToExport.Num());
+	}
+
+	IPlatformFile& File = FPlatformFileManager::Get().GetPlatformFile();
+	TSet<FName> PreparedModules;
+	for (const UStruct* Struct : TypesToExport)
+	{
+		// Create output directories up front, so the parallel saves below don't all race to create them.
+		const FMonoBindingsModule& BindingsModule = FindModule(*Struct);
+		if (!PreparedModules.Contains(BindingsModule.GetModuleName()))
+		{
+			PreparedModules.Add(BindingsModule.GetModuleName());
+			if (!File.CreateDirectoryTree(*BindingsModule.GetGeneratedSourceDirectory()))
+			{
+				UE_LOG(LogMonoScriptGenerator, Error, TEXT("Could not create directory %s"), *BindingsModule.GetGeneratedSourceDirectory());
+			}
+		}
+	}
+
+	TArray<FMonoTypeGlue> TypeGlue;
+	GenerateTypeGlue(TypesToExport, TypeGlue, bParallelGlueGeneration);
+
+	ParallelFor(TypeGlue.Num(), [this, &TypeGlue](int32 Index)
+	{
+		SaveTypeGlue(TypeGlue[Index].Struct, TypeGlue[Index].Glue);
+	}, !bParallelGlueGeneration);
+
+	// merge in export order, so the extensions file is the same however the glue was generated
+	for (const FMonoTypeGlue& Glue : TypeGlue)
+	{
+		if (Glue.ExtensionMethods.Num() > 0)
+		{
+			const FMonoBindingsModule& BindingsModule = FindModule(*Glue.Struct);
+			ExtensionMethods.FindOrAdd(BindingsModule.GetModuleName()).Append(Glue.ExtensionMethods);
+		}
+	}
+}
+
+void FMonoScriptCodeGenerator::GenerateTypeGlue(const TArray<const UStruct*>& TypesToExport, TArray<FMonoTypeGlue>& OutTypeGlue, bool bParallel) const
+{
+	// UPackage::GetMetaData may create the metadata object, which isn't safe off the game thread
+	for (const UStruct* Struct : TypesToExport)
+	{
+		Struct->GetOutermost()->GetMetaData();
+	}
+
+	// each type's glue only depends on the export set, so the types can be generated independently
+	OutTypeGlue.SetNum(TypesToExport.Num());
+	ParallelFor(TypesToExport.Num(), [this, &TypesToExport, &OutTypeGlue](int32 Index)
+	{
+		FMonoTypeGlue& Glue = OutTypeGlue[Index];
+		Glue.Struct = TypesToExport[Index];
+
+		if (const UClass* Class = Cast<UClass>(Glue.Struct))
+		{
+			UE_LOG(LogMonoScriptGenerator, Log, TEXT("Exporting class %s.%s"), *MonoScriptCodeGeneratorUtils::GetModuleName(*Class), *GetScriptNameMapper().MapClassName(Class));
+			Glue.Glue = ExportClass(Class, Glue.ExtensionMethods);
+		}
+		else
+		{
+			const UScriptStruct* Struct = CastChecked<UScriptStruct>(Glue.Struct);
+			UE_LOG(LogMonoScriptGenerator, Log, TEXT("Exporting struct %s.%s"), *MonoScriptCodeGeneratorUtils::GetModuleName(*Struct), *GetScriptNameMapper().MapStructName(Struct));
+			Glue.Glue = ExportStruct(Struct);
+		}
+	}, !bParallel);
+}
+
+bool FMonoScriptCodeGenerator::VerifyParallelGlueGeneration(TArray<FString>& OutMismatchedTypes)
+{
+	bModuleRegistrationOpen = true;
+
+	TArray<const UStruct*> TypesToExport;
+	GatherTypesToExport(TypesToExport);
+
+	TArray<FMonoTypeGlue> SerialGlue;
+	GenerateTypeGlue(TypesToExport, SerialGlue, false);
+
+	TArray<FMonoTypeGlue> ParallelGlue;
+	GenerateTypeGlue(TypesToExport, ParallelGlue, true);
+
+	check(SerialGlue.Num() == ParallelGlue.Num());
+	for (int32 Index = 0; Index < SerialGlue.Num(); ++Index)
+	{
+		const FMonoTypeGlue& Serial = SerialGlue[Index];
+		const FMonoTypeGlue& Parallel = ParallelGlue[Index];
+
+		bool bExtensionMethodsMatch = Serial.ExtensionMethods.Num() == Parallel.ExtensionMethods.Num();
+		for (int32 MethodIndex = 0; bExtensionMethodsMatch && MethodIndex < Serial.ExtensionMethods.Num(); ++MethodIndex)
+		{
+			bExtensionMethodsMatch = Serial.ExtensionMethods[MethodIndex].Function == Parallel.ExtensionMethods[MethodIndex].Function;
+		}
+
+		if (!bExtensionMethodsMatch || !Serial.Glue.Equals(Parallel.Glue, ESearchCase::CaseSensitive))
+		{
+			OutMismatchedTypes.Add(Serial.Struct->GetPathName());
+		}
+	}
+
+	return TypesToExport.Num() > 0;
+}
+
+void FMonoScriptCodeGenerator::ExportTypeGlue(TSet<FName>& OutUpToDateModules)
+{
+	bModuleRegistrationOpen = true;
+
+	ExportClasses();
+	GeneratedFileManager.RenameTempFiles();
+
+	SaveGlueModuleStates();
+	ModulesChangedByUHT.Empty();
+
+	OutUpToDateModules = UpToDateModules;
+}
+
+void FMonoScriptCodeGenerator::GatherTypesToExport(TArray<const UStruct*>& OutTypesToExport)
 {
 	TSet<UClass*> ExportedClasses;
 	TSet<UScriptStruct*> ExportedStructs;
@@ -364,17 +529,15 @@ void FMonoScriptCodeGenerator::ExportClasses()
 		}
 	}
 
-	// export full classes
+	// full classes first, then structs
 	for (const UClass* Class : ExportedClasses)
 	{
-		UE_LOG(LogMonoScriptGenerator, Log, TEXT("Exporting class %s.%s"), *MonoScriptCodeGeneratorUtils::GetModuleName(*Class), *GetScriptNameMapper().MapClassName (Class));
-		ExportClass(Class);
+		OutTypesToExport.Add(Class);
 	}
 
 	for (const UScriptStruct* Struct : ExportedStructs)
 	{
-		UE_LOG(LogMonoScriptGenerator, Log, TEXT("Exporting struct %s.%s"), *MonoScriptCodeGeneratorUtils::GetModuleName(*Struct), *GetScriptNameMapper().MapStructName(Struct));
-		ExportStruct(Struct);
+		OutTypesToExport.Add(Struct);
 	}
 }
 
@@ -661,7 +824,7 @@ void FMonoScriptCodeGenerator::CollapseGettersAndSetters(TArray<FCollapsedGetter
 	}
 }
 
-void FMonoScriptCodeGenerator::ExportClass(const UClass* Class)
+FString FMonoScriptCodeGenerator::ExportClass(const UClass* Class, TArray<ExtensionMethod>& OutExtensionMethods) const
 {
 	check(Class);
 	check(CanExportClass(Class));
@@ -723,6 +886,8 @@ void FMonoScriptCodeGenerator::ExportClass(const UClass* Class)
 		FMonoCSharpPropertyBuilder PropBuilder;
 
 		PropBuilder.AddAttribute(TEXT("UClass(UserClassFlags.NativeBindingsClass)"));
+		// the native constructor below only stores the native pointer, so the runtime is free to skip it
+		PropBuilder.AddAttribute(TEXT("TrivialWrapper"));
 		PropBuilder.AddMetaData(*Class);
 		PropBuilder.Finish();
 
@@ -802,7 +967,7 @@ void FMonoScriptCodeGenerator::ExportClass(const UClass* Class)
 
 	if (ExportedFunctions.Num() > 0)
 	{
-		ExportClassFunctions(Builder, Class, ExportedFunctions);
+		ExportClassFunctions(Builder, Class, ExportedFunctions, OutExtensionMethods);
 	}
 
 	if (ExportedOverridableFunctions.Num() > 0)
@@ -820,6 +985,7 @@ void FMonoScriptCodeGenerator::ExportClass(const UClass* Class)
 		// for abstract classes, create a sealed wrapper only version of the class
 		// This is so we can expose objects we may not have generated bindings for, we can expose them as the
 		// most derived super class we have bindings for
+		Builder.AppendLine(TEXT("[TrivialWrapper]"));
 		Builder.AppendLine(FString::Printf(TEXT("sealed class %s_WrapperOnly : %s"), *MappedClassName, *MappedClassName));
 		Builder.OpenBrace();
 
@@ -836,10 +1002,10 @@ void FMonoScriptCodeGenerator::ExportClass(const UClass* Class)
 	}
 	Builder.CloseBrace(); // close namespace
 
-	SaveTypeGlue(Class, Builder.ToText().ToString());
+	return Builder.ToText().ToString();
 }
 
-void FMonoScriptCodeGenerator::ExportStruct(const UScriptStruct* Struct)
+FString FMonoScriptCodeGenerator::ExportStruct(const UScriptStruct* Struct) const
 {
 	check(Struct);
 	const FMonoBindingsModule& BindingsModule = FindModule(*Struct);
@@ -913,11 +1079,10 @@ void FMonoScriptCodeGenerator::ExportStruct(const UScriptStruct* Struct)
 
 	Builder.CloseBrace(); // namespace
 
-
-	SaveTypeGlue(Struct, Builder.ToText().ToString());
+	return Builder.ToText().ToString();
 }
 
-void FMonoScriptCodeGenerator::ExportMirrorStructMarshalling(FMonoTextBuilder& Builder, const UScriptStruct* Struct, TArray<UProperty*> ExportedProperties)
+void FMonoScriptCodeGenerator::ExportMirrorStructMarshalling(FMonoTextBuilder& Builder, const UScriptStruct* Struct, TArray<UProperty*> ExportedProperties) const
 {
 	Builder.AppendLine();
 	Builder.AppendLine(TEXT("// Construct by marshalling from a native buffer."));
@@ -967,7 +1132,7 @@ void FMonoScriptCodeGenerator::ExportMirrorStructMarshalling(FMonoTextBuilder& B
 	Builder.CloseBrace(); // ToNative
 }
 
-void FMonoScriptCodeGenerator::ExportStructMarshaler(FMonoTextBuilder& Builder, const UScriptStruct* Struct)
+void FMonoScriptCodeGenerator::ExportStructMarshaler(FMonoTextBuilder& Builder, const UScriptStruct* Struct) const
 {
 	FString StructName = NameMapper.MapStructName(Struct);
 
@@ -1089,7 +1254,7 @@ bool FMonoScriptCodeGenerator::CanExportProperty(const UStruct* Struct, UPropert
 			|| (!bIsClassProperty && !Handler.IsSupportedAsStructProperty()) 
 			|| !Handler.CanHandleProperty(Property))
 		{
-			++UnhandledProperties.FindOrAdd(Property->GetClass()->GetFName());
+			CountUnhandledProperty(UnhandledProperties, Property);
 			bCanExport = false;
 		}
 	}
@@ -1113,7 +1278,7 @@ bool FMonoScriptCodeGenerator::CanExportParameter(const UProperty* Property) con
 
 	if (!bCanExport)
 	{
-		++UnhandledParameters.FindOrAdd(Property->GetClass()->GetFName());
+		CountUnhandledProperty(UnhandledParameters, Property);
 	}
 
 	return bCanExport;
@@ -1128,7 +1293,7 @@ bool FMonoScriptCodeGenerator::CanExportReturnValue(const UProperty* Property) c
 		const FMonoPropertyHandler& Handler = PropertyHandlers->Find(Property);
 		if (!Handler.IsSupportedAsReturnValue() || !Handler.CanHandleProperty(Property))
 		{
-			++UnhandledReturnValues.FindOrAdd(Property->GetClass()->GetFName());
+			CountUnhandledProperty(UnhandledReturnValues, Property);
 			bCanExport = false;
 		}
 	}
@@ -1189,7 +1354,7 @@ bool FMonoScriptCodeGenerator::CanExportOverridableParameter(const UProperty* Pr
 
 	if (!bCanExport)
 	{
-		++UnhandledOverridableParameters.FindOrAdd(Property->GetClass()->GetFName());
+		CountUnhandledProperty(UnhandledOverridableParameters, Property);
 	}
 
 	return bCanExport;
@@ -1210,7 +1375,7 @@ bool FMonoScriptCodeGenerator::CanExportOverridableReturnValue(const UProperty*
 
 	if (!bCanExport)
 	{
-		++UnhandledOverridableReturnValues.FindOrAdd(Property->GetClass()->GetFName());
+		CountUnhandledProperty(UnhandledOverridableReturnValues, Property);
 	}
 
 	return bCanExport;
@@ -1382,26 +1547,69 @@ void FMonoScriptCodeGenerator::ExportStaticConstructor(
 
 		Builder.AppendLine();
 
-		ExportPropertiesStaticConstruction(Builder, ExportedProperties, CollapsedGettersAndSetters);
+		if (bBakeNativeLayout)
+		{
+			// Offsets and sizes from this process are only valid if the running build has the same layout, so keep the dynamic lookups as a fallback.
+			const FMonoBindingsModule& Bindings = FindModule(*Struct);
+			{
+				FScopeLock Lock(&BakedLayoutModulesLock);
+				BakedLayoutModules.Add(Bindings.GetModuleName());
+			}
 
-		if (nullptr != Class)
+			Builder.AppendLine(FString::Printf(TEXT("if (%s.%s.IsValid)"), *Bindings.GetNamespace(), *GetBakedLayoutClassName(Bindings.GetModuleName())));
+			Builder.OpenBrace();
+			ExportStaticConstructorBody(Builder, Struct, ExportedProperties, ExportedFunctions, ExportedOverrideableFunctions, CollapsedGettersAndSetters, true);
+			Builder.CloseBrace();
+			Builder.AppendLine(TEXT("else"));
+			Builder.OpenBrace();
+			ExportStaticConstructorBody(Builder, Struct, ExportedProperties, ExportedFunctions, ExportedOverrideableFunctions, CollapsedGettersAndSetters, false);
+			Builder.CloseBrace();
+		}
+		else
 		{
-			Builder.AppendLine();
-			ExportClassFunctionsStaticConstruction(Builder, Class, ExportedFunctions, CollapsedGettersAndSetters);
+			ExportStaticConstructorBody(Builder, Struct, ExportedProperties, ExportedFunctions, ExportedOverrideableFunctions, CollapsedGettersAndSetters, false);
+		}
 
-			Builder.AppendLine();
-			ExportClassOverridableFunctionsStaticConstruction(Builder, Class, ExportedOverrideableFunctions);
+		Builder.CloseBrace(); // static ctor
+	}
+}
 
-			Builder.AppendLine();
+void FMonoScriptCodeGenerator::ExportStaticConstructorBody(
+	FMonoTextBuilder& Builder,
+	const UStruct* Struct,
+	const TArray<UProperty*>& ExportedProperties,
+	const TArray<UFunction*>& ExportedFunctions,
+	const TArray<UFunction*>& ExportedOverrideableFunctions,
+	const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters,
+	bool bBakedLayout) const
+{
+	const UClass* Class = Cast<UClass>(Struct);
+	const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(Struct);
+
+	ExportPropertiesStaticConstruction(Builder, ExportedProperties, CollapsedGettersAndSetters, bBakedLayout);
+
+	if (nullptr != Class)
+	{
+		Builder.AppendLine();
+		ExportClassFunctionsStaticConstruction(Builder, Class, ExportedFunctions, CollapsedGettersAndSetters, bBakedLayout);
+
+		Builder.AppendLine();
+		ExportClassOverridableFunctionsStaticConstruction(Builder, Class, ExportedOverrideableFunctions, bBakedLayout);
+
+		Builder.AppendLine();
+	}
+	else
+	{
+		check(nullptr != ScriptStruct);
+		Builder.AppendLine();
+		if (bBakedLayout)
+		{
+			Builder.AppendLine(FString::Printf(TEXT("NativeDataSize = %d;"), Mono::GetBakedStructSize(*ScriptStruct)));
 		}
 		else
 		{
-			check(nullptr != ScriptStruct);
-			Builder.AppendLine();
 			Builder.AppendLine(TEXT("NativeDataSize = UnrealInterop.GetNativeStructSize(NativeClassPtr);"));
 		}
-
-		Builder.CloseBrace(); // static ctor
 	}
 }
 
@@ -1550,10 +1758,11 @@ void FMonoScriptCodeGenerator::ExportClassCollapsedGettersAndSetters(FMonoTextBu
 	}
 }
 
-void FMonoScriptCodeGenerator::ExportPropertiesStaticConstruction(FMonoTextBuilder& Builder, const TArray<UProperty*>& ExportedProperties, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters) const
+void FMonoScriptCodeGenerator::ExportPropertiesStaticConstruction(FMonoTextBuilder& Builder, const TArray<UProperty*>& ExportedProperties, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, bool bBakedLayout) const
 {
 	//we already warn on conflicts when exporting the properties themselves, so here we can just silently skip them
 	TSet<FString> ExportedPropertiesHash;
+	TArray<UProperty*> StaticConstructionProperties;
 
 	for (UProperty* Property : ExportedProperties)
 	{
@@ -1564,7 +1773,7 @@ void FMonoScriptCodeGenerator::ExportPropertiesStaticConstruction(FMonoTextBuild
 		}
 		ExportedPropertiesHash.Add(ManagedName);
 
-		PropertyHandlers->Find(Property).ExportPropertyStaticConstruction(Builder, Property, Property->GetName());
+		StaticConstructionProperties.Add(Property);
 	}
 
 	for (auto&& Collapsed : CollapsedGettersAndSetters)
@@ -1577,9 +1786,75 @@ void FMonoScriptCodeGenerator::ExportPropertiesStaticConstruction(FMonoTextBuild
 
 		if (Collapsed.Property != nullptr && Collapsed.Getter == nullptr)
 		{
-			PropertyHandlers->Find(Collapsed.Property).ExportPropertyStaticConstruction(Builder, Collapsed.Property, Collapsed.Property->GetName());
+			StaticConstructionProperties.Add(Collapsed.Property);
+		}
+	}
+
+	// fetch everything the properties need in a single native call rather than several per property.
+	// Baked offsets don't need the lookup, but some properties still need their UProperty pointer.
+	TArray<UProperty*> LookupProperties;
+	for (UProperty* Property : StaticConstructionProperties)
+	{
+		if (!bBakedLayout || PropertyHandlers->Find(Property).NeedsNativePropertyInStaticConstruction())
+		{
+			LookupProperties.Add(Property);
 		}
 	}
+
+	if (LookupProperties.Num() > 0)
+	{
+		ExportNativePropertyInfosLookup(Builder, TEXT("NativePropertyInfos"), TEXT("NativeClassPtr"), LookupProperties);
+	}
+
+	for (UProperty* Property : StaticConstructionProperties)
+	{
+		const int32 LookupIndex = LookupProperties.Find(Property);
+		const FString PropertyInfo = LookupIndex != INDEX_NONE ? FString::Printf(TEXT("NativePropertyInfos[%d]"), LookupIndex) : FString();
+		PropertyHandlers->Find(Property).ExportPropertyStaticConstruction(Builder, Property, Property->GetName(), PropertyInfo, bBakedLayout);
+	}
+}
+
+void FMonoScriptCodeGenerator::ExportNativePropertyInfosLookup(FMonoTextBuilder& Builder, const FString& InfosVariableName, const FString& NativeStructExpression, const TArray<UProperty*>& Properties) const
+{
+	TArray<FString> PropertyNames;
+	for (UProperty* Property : Properties)
+	{
+		PropertyNames.Add(Property->GetName());
+	}
+
+	Builder.AppendLine(FString::Printf(TEXT("UnrealInterop.NativePropertyInfo[] %s = UnrealInterop.GetNativePropertyInfos(%s, \"%s\", %d);"),
+		*InfosVariableName,
+		*NativeStructExpression,
+		*FString::Join(PropertyNames, TEXT(";")),
+		PropertyNames.Num()));
+}
+
+void FMonoScriptCodeGenerator::ExportParametersStaticConstruction(FMonoTextBuilder& Builder, const UFunction* Function, const FString& NativeMethodName, bool bBakedLayout) const
+{
+	TArray<UProperty*> Parameters;
+	for (TFieldIterator<UProperty> It(Function, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		Parameters.Add(*It);
+	}
+
+	if (Parameters.Num() == 0)
+	{
+		return;
+	}
+
+	const FString InfosVariableName = FString::Printf(TEXT("%s_ParamInfos"), *NativeMethodName);
+	if (!bBakedLayout)
+	{
+		ExportNativePropertyInfosLookup(Builder, InfosVariableName, FString::Printf(TEXT("%s_NativeFunction"), *NativeMethodName), Parameters);
+	}
+
+	for (int32 ParamIndex = 0; ParamIndex < Parameters.Num(); ++ParamIndex)
+	{
+		UProperty* Property = Parameters[ParamIndex];
+		const FMonoPropertyHandler& ParamHandler = PropertyHandlers->Find(Property);
+		const FString ParamInfo = bBakedLayout ? FString() : FString::Printf(TEXT("%s[%d]"), *InfosVariableName, ParamIndex);
+		ParamHandler.ExportParameterStaticConstruction(Builder, NativeMethodName, Property, ParamInfo, bBakedLayout);
+	}
 }
 
 void FMonoScriptCodeGenerator::GatherExportedStructs(TArray<UScriptStruct*>& ExportedStructs, const UClass* Class) const
@@ -1626,7 +1901,7 @@ void FMonoScriptCodeGenerator::GatherExportedOverridableFunctions(TArray<UFuncti
 	}
 }
 
-void FMonoScriptCodeGenerator::ExportClassFunctions(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions)
+void FMonoScriptCodeGenerator::ExportClassFunctions(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, TArray<ExtensionMethod>& OutExtensionMethods) const
 {
 	Builder.AppendLine();
 	Builder.AppendLine(TEXT("// UFunctions"));
@@ -1641,9 +1916,8 @@ void FMonoScriptCodeGenerator::ExportClassFunctions(FMonoTextBuilder& Builder, c
 			{
 				FuncType = FMonoPropertyHandler::FunctionType::ExtensionOnAnotherClass;
 
-				const FMonoBindingsModule& BindingsModule = FindModule(*Class);
-				TArray<ExtensionMethod>& ModuleExtensionMethods = ExtensionMethods.FindOrAdd(BindingsModule.GetModuleName());
-				ModuleExtensionMethods.Add(Method);
+				// merged into ExtensionMethods by ExportClasses, in export order
+				OutExtensionMethods.Add(Method);
 			}
 			else if (ManualLibraryFunctionList.HasFunction(Class, Function))
 			{
@@ -1666,57 +1940,62 @@ void FMonoScriptCodeGenerator::ExportClassOverridableFunctions(FMonoTextBuilder&
 	}
 }
 
-void FMonoScriptCodeGenerator::ExportClassFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters) const
+void FMonoScriptCodeGenerator::ExportClassFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, bool bBakedLayout) const
 {
 	for (UFunction* Function : ExportedFunctions)
 	{
-		ExportClassFunctionStaticConstruction(Builder, Function);
+		ExportClassFunctionStaticConstruction(Builder, Function, bBakedLayout);
 	}
 
 	for (auto&& Collapsed : CollapsedGettersAndSetters)
 	{
 		if (Collapsed.Getter != nullptr)
 		{
-			ExportClassFunctionStaticConstruction(Builder, Collapsed.Getter);
+			ExportClassFunctionStaticConstruction(Builder, Collapsed.Getter, bBakedLayout);
 		}
 		if (Collapsed.Setter != nullptr)
 		{
-			ExportClassFunctionStaticConstruction(Builder, Collapsed.Setter);
+			ExportClassFunctionStaticConstruction(Builder, Collapsed.Setter, bBakedLayout);
 		}
 	}
 }
 
-void FMonoScriptCodeGenerator::ExportClassFunctionStaticConstruction(FMonoTextBuilder& Builder, const UFunction *Function) const
+void FMonoScriptCodeGenerator::ExportFunctionParamsSizeStaticConstruction(FMonoTextBuilder& Builder, const UFunction* Function, const FString& NativeMethodName, bool bBakedLayout) const
 {
-	FString NativeMethodName = Function->GetName ();
-	Builder.AppendLine(FString::Printf(TEXT("%s_NativeFunction = GetNativeFunctionFromClassAndName(NativeClassPtr, \"%s\");"), *NativeMethodName, *Function->GetName()));
-	if (Function->NumParms > 0)
+	if (bBakedLayout)
+	{
+		Builder.AppendLine(FString::Printf(TEXT("%s_ParamsSize = %d;"), *NativeMethodName, Function->ParmsSize));
+	}
+	else
 	{
 		Builder.AppendLine(FString::Printf(TEXT("%s_ParamsSize = GetNativeFunctionParamsSize(%s_NativeFunction);"), *NativeMethodName, *NativeMethodName));
 	}
-	for (TFieldIterator<UProperty> It(Function, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+}
+
+void FMonoScriptCodeGenerator::ExportClassFunctionStaticConstruction(FMonoTextBuilder& Builder, const UFunction *Function, bool bBakedLayout) const
+{
+	FString NativeMethodName = Function->GetName ();
+	Builder.AppendLine(FString::Printf(TEXT("%s_NativeFunction = GetNativeFunctionFromClassAndName(NativeClassPtr, \"%s\");"), *NativeMethodName, *Function->GetName()));
+	if (Function->NumParms > 0)
 	{
-		UProperty* Property = *It;
-		const FMonoPropertyHandler& ParamHandler = PropertyHandlers->Find(Property);
-		ParamHandler.ExportParameterStaticConstruction(Builder, NativeMethodName, Property);
+		ExportFunctionParamsSizeStaticConstruction(Builder, Function, NativeMethodName, bBakedLayout);
 	}
+	ExportParametersStaticConstruction(Builder, Function, NativeMethodName, bBakedLayout);
 }
 
-void FMonoScriptCodeGenerator::ExportClassOverridableFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedOverridableFunctions) const
+void FMonoScriptCodeGenerator::ExportClassOverridableFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedOverridableFunctions, bool bBakedLayout) const
 {
 	for (UFunction* Function : ExportedOverridableFunctions)
 	{
 		if (Function->NumParms)
 		{
 			FString NativeMethodName = Function->GetName();
-			Builder.AppendLine(FString::Printf(TEXT("IntPtr %s_NativeFunction = GetNativeFunctionFromClassAndName(NativeClassPtr, \"%s\");"), *NativeMethodName, *NativeMethodName));
-			Builder.AppendLine(FString::Printf(TEXT("%s_ParamsSize = GetNativeFunctionParamsSize(%s_NativeFunction);"), *NativeMethodName, *NativeMethodName));
-			for (TFieldIterator<UProperty> It(Function, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+			if (!bBakedLayout)
 			{
-				UProperty* Property = *It;
-				const FMonoPropertyHandler& ParamHandler = PropertyHandlers->Find(Property);
-				ParamHandler.ExportParameterStaticConstruction(Builder, NativeMethodName, Property);
+				Builder.AppendLine(FString::Printf(TEXT("IntPtr %s_NativeFunction = GetNativeFunctionFromClassAndName(NativeClassPtr, \"%s\");"), *NativeMethodName, *NativeMethodName));
 			}
+			ExportFunctionParamsSizeStaticConstruction(Builder, Function, NativeMethodName, bBakedLayout);
+			ExportParametersStaticConstruction(Builder, Function, NativeMethodName, bBakedLayout);
 
 			Builder.AppendLine();
 		}
@@ -1968,6 +2247,7 @@ void FMonoScriptCodeGenerator::RegisterClassModule(UStruct* Struct, const TSet<U
 
 	check(!BindingsModule.ExportedTypes.Contains(Struct->GetFName()));
 	BindingsModule.ExportedTypes.Add(Struct->GetFName());
+	BindingsModule.TypeReferences.Append(References);
 
 	for (auto ReferencedClass : References)
 	{
@@ -2031,6 +2311,46 @@ void FMonoScriptCodeGenerator::ExportModules(const TSet<FName>& ModulesToExport)
 	}
 }
 
+FString FMonoScriptCodeGenerator::GetBakedLayoutClassName(FName ModuleFName)
+{
+	return ModuleFName.ToString() + TEXT("BakedLayout");
+}
+
+void FMonoScriptCodeGenerator::ExportBakedLayouts()
+{
+	for (FName ModuleFName : BakedLayoutModules)
+	{
+		FMonoBindingsModule& Bindings = FindOrRegisterModule(ModuleFName);
+		Bindings.bExportBakedLayout = true;
+
+		UPackage* Package = FindPackage(nullptr, *FString::Printf(TEXT("/Script/%s"), *ModuleFName.ToString()));
+		check(Package);
+
+		FMonoTextBuilder Builder(FMonoTextBuilder::IndentType::Spaces);
+
+		Builder.AppendLine(TEXT("using System;"));
+		Builder.AppendLine(FString::Printf(TEXT("using %s;"), MONO_BINDINGS_NAMESPACE));
+		Builder.AppendLine();
+		Builder.AppendLine();
+		Builder.AppendLine(FString::Printf(TEXT("namespace %s"), *Bindings.GetNamespace()));
+		Builder.OpenBrace();
+
+		Builder.AppendLine(TEXT("// Static constructors in this module use the offsets and sizes baked in at generation time when the"));
+		Builder.AppendLine(TEXT("// running build's layout hash matches, and fall back to looking them up otherwise."));
+		Builder.AppendLine(FString::Printf(TEXT("internal static class %s"), *GetBakedLayoutClassName(ModuleFName)));
+		Builder.OpenBrace();
+		Builder.AppendLine(FString::Printf(TEXT("const uint LayoutHash = 0x%08Xu;"), Mono::ComputeBakedLayoutHash(*Package)));
+		Builder.AppendLine(FString::Printf(TEXT("public static readonly bool IsValid = UnrealInterop.ValidateBakedLayout(\"%s\", LayoutHash);"), *ModuleFName.ToString()));
+		Builder.CloseBrace(); // class
+
+		Builder.CloseBrace(); // namespace
+
+		SaveBakedLayoutGlue(Bindings, Builder.ToText().ToString());
+	}
+
+	BakedLayoutModules.Empty();
+}
+
 static FString GetClassExportFilename(FName ClassFName)
 {
 	return ClassFName.ToString() + TEXT(".cs");
@@ -2041,6 +2361,11 @@ static FString GetModuleExportFilename(FName ModuleFName)
 	return ModuleFName.ToString() + TEXT("Module.cs");
 }
 
+static FString GetModuleBakedLayoutFilename(FName ModuleFName)
+{
+	return ModuleFName.ToString() + TEXT("BakedLayout.cs");
+}
+
 static FString GetModuleExtensionsFilename(FName ModuleFName)
 {
 	return ModuleFName.ToString() + TEXT("Extensions.cs");
@@ -2090,6 +2415,194 @@ void FMonoScriptCodeGenerator::SaveExtensionsGlue(const FMonoBindingsModule& Bin
 	SaveGlue(Bindings, GetModuleExtensionsFilename(Bindings.GetModuleName()), GeneratedGlue);
 }
 
+void FMonoScriptCodeGenerator::SaveBakedLayoutGlue(const FMonoBindingsModule& Bindings, const FString& GeneratedGlue)
+{
+	SaveGlue(Bindings, GetModuleBakedLayoutFilename(Bindings.GetModuleName()), GeneratedGlue);
+}
+
+void FMonoScriptCodeGenerator::ComputeModuleInputHashes(const TArray<const UStruct*>& TypesToExport)
+{
+	TMap<const UStruct*, uint32> SignatureHashes;
+	auto GetSignatureHash = [&SignatureHashes](const UStruct* Struct)
+	{
+		if (const uint32* Hash = SignatureHashes.Find(Struct))
+		{
+			return *Hash;
+		}
+		return SignatureHashes.Add(Struct, MonoScriptCodeGeneratorUtils::ComputeTypeSignatureHash(*Struct));
+	};
+	auto SortByPathName = [](const UStruct& A, const UStruct& B) { return A.GetPathName() < B.GetPathName(); };
+
+	// the generator itself is an input, rebuilding it invalidates all glue
+	const FString GeneratorModuleFilename = FModuleManager::Get().GetModuleFilename(TEXT("MonoScriptGenerator"));
+	const int64 GeneratorTimestamp = IFileManager::Get().GetTimeStamp(*GeneratorModuleFilename).GetTicks();
+
+	TMap<FName, TArray<const UStruct*>> TypesByModule;
+	for (const UStruct* Struct : TypesToExport)
+	{
+		TypesByModule.FindOrAdd(MonoScriptCodeGeneratorUtils::GetModuleFName(*Struct)).Add(Struct);
+	}
+
+	ModuleInputHashes.Empty();
+	for (auto& ModuleTypes : TypesByModule)
+	{
+		TArray<const UStruct*>& Types = ModuleTypes.Value;
+		Types.Sort(SortByPathName);
+
+		uint32 Hash = FCrc::MemCrc32(&GeneratorTimestamp, sizeof(GeneratorTimestamp));
+		Hash = FCrc::MemCrc32(&bBakeNativeLayout, sizeof(bBakeNativeLayout), Hash);
+		if (bBakeNativeLayout)
+		{
+			const uint32 LayoutHash = Mono::ComputeBakedLayoutHash(*Types[0]->GetOutermost());
+			Hash = FCrc::MemCrc32(&LayoutHash, sizeof(LayoutHash), Hash);
+		}
+
+		for (const UStruct* Struct : Types)
+		{
+			const uint32 SignatureHash = GetSignatureHash(Struct);
+			const bool bHasInjectedSource = HasInjectedSource(Struct);
+			Hash = FCrc::MemCrc32(&SignatureHash, sizeof(SignatureHash), Hash);
+			Hash = FCrc::MemCrc32(&bHasInjectedSource, sizeof(bHasInjectedSource), Hash);
+		}
+
+		// glue marshals referenced types by name and layout, so their signatures are inputs too
+		TArray<UStruct*> References = FindModule(ModuleTypes.Key).TypeReferences.Array();
+		References.Sort(SortByPathName);
+		for (const UStruct* Reference : References)
+		{
+			const uint32 SignatureHash = GetSignatureHash(Reference);
+			Hash = FCrc::MemCrc32(&SignatureHash, sizeof(SignatureHash), Hash);
+		}
+
+		ModuleInputHashes.Add(ModuleTypes.Key, Hash);
+	}
+}
+
+void FMonoScriptCodeGenerator::GatherUpToDateModules(TSet<FName>& OutUpToDateModules)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	for (const auto& ModuleInputHash : ModuleInputHashes)
+	{
+		const FName ModuleFName = ModuleInputHash.Key;
+		const FGlueModuleState* PreviousState = PreviousGlueModuleStates.Find(ModuleFName);
+		if (nullptr == PreviousState || PreviousState->InputHash != ModuleInputHash.Value || ModulesChangedByUHT.Contains(ModuleFName))
+		{
+			continue;
+		}
+
+		FMonoBindingsModule& Bindings = FindOrRegisterModule(ModuleFName);
+
+		// the glue has to still be there, in case someone cleaned the output directory
+		TArray<FString> ExpectedFiles;
+		for (FName ExportedType : Bindings.ExportedTypes)
+		{
+			ExpectedFiles.Add(GetClassExportFilename(ExportedType));
+		}
+		if (PreviousState->bExportExtensions)
+		{
+			ExpectedFiles.Add(GetModuleExtensionsFilename(ModuleFName));
+		}
+		if (PreviousState->bExportBakedLayout)
+		{
+			ExpectedFiles.Add(GetModuleBakedLayoutFilename(ModuleFName));
+		}
+
+		bool bAllFilesExist = true;
+		for (FString& ExpectedFile : ExpectedFiles)
+		{
+			ExpectedFile = FPaths::Combine(*Bindings.GetGeneratedSourceDirectory(), *ExpectedFile);
+			if (!FileManager.FileExists(*ExpectedFile))
+			{
+				bAllFilesExist = false;
+				break;
+			}
+		}
+
+		if (bAllFilesExist)
+		{
+			// skipped, but still generated, so their hashes stay in the manifest
+			for (const FString& ExpectedFile : ExpectedFiles)
+			{
+				GeneratedFileManager.KeepFile(ExpectedFile);
+			}
+
+			// these are normally set as the glue is exported, and decide which files the project includes
+			Bindings.bExportExtensions = PreviousState->bExportExtensions;
+			Bindings.bExportBakedLayout = PreviousState->bExportBakedLayout;
+			OutUpToDateModules.Add(ModuleFName);
+		}
+	}
+}
+
+void FMonoScriptCodeGenerator::LoadGlueModuleStates()
+{
+	PreviousGlueModuleStates.Empty();
+
+	FString StateContents;
+	if (!FFileHelper::LoadFileToString(StateContents, *GlueModuleStatePath))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> State;
+	auto JsonReader = TJsonReaderFactory<>::Create(StateContents);
+	const TArray<TSharedPtr<FJsonValue>>* Modules = nullptr;
+	if (!FJsonSerializer::Deserialize(JsonReader, State) || !State.IsValid() || !State->TryGetArrayField(TEXT("Modules"), Modules))
+	{
+		UE_LOG(LogMonoScriptGenerator, Warning, TEXT("Ignoring malformed glue module state: '%s'"), *GlueModuleStatePath);
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& ModuleValue : *Modules)
+	{
+		const TSharedPtr<FJsonObject>* ModuleObject = nullptr;
+		FString ModuleName;
+		FString InputHash;
+		if (ModuleValue->TryGetObject(ModuleObject)
+			&& (*ModuleObject)->TryGetStringField(TEXT("Name"), ModuleName)
+			&& (*ModuleObject)->TryGetStringField(TEXT("InputHash"), InputHash))
+		{
+			FGlueModuleState& ModuleState = PreviousGlueModuleStates.Add(FName(*ModuleName));
+			ModuleState.InputHash = static_cast<uint32>(FCString::Strtoui64(*InputHash, nullptr, 16));
+			ModuleState.bExportExtensions = (*ModuleObject)->GetBoolField(TEXT("Extensions"));
+			ModuleState.bExportBakedLayout = (*ModuleObject)->GetBoolField(TEXT("BakedLayout"));
+		}
+	}
+}
+
+void FMonoScriptCodeGenerator::SaveGlueModuleStates() const
+{
+	TArray<FName> ModuleNames;
+	ModuleInputHashes.GetKeys(ModuleNames);
+	ModuleNames.Sort(FNameLexicalLess());
+
+	TArray<TSharedPtr<FJsonValue>> Modules;
+	for (FName ModuleFName : ModuleNames)
+	{
+		const FMonoBindingsModule& Bindings = FindModule(ModuleFName);
+
+		TSharedPtr<FJsonObject> ModuleObject = MakeShareable(new FJsonObject);
+		ModuleObject->SetStringField(TEXT("Name"), ModuleFName.ToString());
+		ModuleObject->SetStringField(TEXT("InputHash"), FString::Printf(TEXT("%08x"), ModuleInputHashes.FindChecked(ModuleFName)));
+		ModuleObject->SetBoolField(TEXT("Extensions"), Bindings.bExportExtensions);
+		ModuleObject->SetBoolField(TEXT("BakedLayout"), Bindings.bExportBakedLayout);
+		Modules.Add(MakeShareable(new FJsonValueObject(ModuleObject)));
+	}
+
+	TSharedPtr<FJsonObject> State = MakeShareable(new FJsonObject);
+	State->SetArrayField(TEXT("Modules"), Modules);
+
+	FString OutputString;
+	auto JsonWriter = TJsonWriterFactory<>::Create(&OutputString);
+	verify(FJsonSerializer::Serialize(State.ToSharedRef(), JsonWriter));
+
+	if (!FFileHelper::SaveStringToFile(OutputString, *GlueModuleStatePath))
+	{
+		UE_LOG(LogMonoScriptGenerator, Warning, TEXT("Failed to save glue module state: '%s'"), *GlueModuleStatePath);
+	}
+}
+
 struct GameSolutionInfo
 {
 	TArray<TSharedPtr<FMonoProjectFile>> Projects;
@@ -2537,6 +3050,11 @@ void FMonoScriptCodeGenerator::GenerateProjectFile(const FMonoProjectFile& Proje
 				ExpectedInputFiles.Add(GetModuleExtensionsFilename(ModuleFName));
 			}
 
+			if (BindingsModule.bExportBakedLayout)
+			{
+				ExpectedInputFiles.Add(GetModuleBakedLayoutFilename(ModuleFName));
+			}
+
 			TArray<FString> InputFiles;
 			IFileManager& FileManager = IFileManager::Get();
 			FileManager.FindFiles(InputFiles, *Pattern, true, false);
@@ -2635,6 +3153,13 @@ FString FMonoScriptCodeGenerator::GetProjectReferenceText(const FString& Referen
 	return FString::Printf(TEXT("<ProjectReference Include=\"%s\"><Project>%s</Project><Name>%s</Name><Private>False</Private></ProjectReference>"), *PlatformReferenceeProjectPath, *ReferenceeProjectGuid.ToString(EGuidFormats::DigitsWithHyphensInBraces), *ReferenceeAssemblyName);
 }
  
+void FMonoScriptCodeGenerator::CountUnhandledProperty(UnhandledPropertyCounts& Counts, const UProperty* Property) const
+{
+	// types are exported in parallel
+	FScopeLock Lock(&UnhandledPropertiesLock);
+	++Counts.FindOrAdd(Property->GetClass()->GetFName());
+}
+
 void FMonoScriptCodeGenerator::LogUnhandledProperties() const
 {
 	if (UnhandledProperties.Num() || UnhandledParameters.Num() || UnhandledReturnValues.Num())
@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Templates/UniquePtr.h"
+#include "HAL/CriticalSection.h"
 #include "MonoGeneratedFileManager.h"
 #include "MonoPropertyHandler.h"
 #include "MonoBindingsModule.h"
@@ -37,17 +38,51 @@ public:
 
 	const FString& GetMonoBuildManifestOutputDirectory() const { return MonoBuildManifestOutputDirectory; }
 
+	// Emit property offsets, struct sizes and function param sizes as literals, guarded by a per-module layout hash.
+	// Only valid when the generator runs in a process where the exported types have been linked.
+	void SetBakeNativeLayout(bool bInBakeNativeLayout) { bBakeNativeLayout = bInBakeNativeLayout; }
+
+	// Only regenerate glue for modules whose types, or the types they reference, changed since the last export.
+	void SetIncrementalGlueGeneration(bool bInIncrementalGlueGeneration) { bIncrementalGlueGeneration = bInIncrementalGlueGeneration; }
+	bool IsIncrementalGlueGeneration() const { return bIncrementalGlueGeneration; }
+
+	// Generates glue for the gathered classes on one thread and in parallel, without saving anything, and
+	// reports the types whose output differs. Returns false if there was nothing to export.
+	bool VerifyParallelGlueGeneration(TArray<FString>& OutMismatchedTypes);
+
 	inline const MonoScriptNameMapper& GetScriptNameMapper() const { return NameMapper; }
 
 private:
+	// generates glue for a known type and checks the literals it bakes
+	friend class FMonoScriptGeneratorBakedLayoutTests;
+	// exports type glue twice and checks which modules the second, incremental export skips
+	friend class FMonoScriptGeneratorIncrementalGlueTests;
+
 	FString GetQualifiedSuperClassName(const UClass* Class) const;
 
+	struct ExtensionMethod;
+	struct FMonoTypeGlue;
+
 	void ExportClasses();
+	void GatherTypesToExport(TArray<const UStruct*>& OutTypesToExport);
+	void GenerateTypeGlue(const TArray<const UStruct*>& TypesToExport, TArray<FMonoTypeGlue>& OutTypeGlue, bool bParallel) const;
 	void ExportExtensionMethods();
 	void ExportModules(const TSet<FName>& ModulesToExport);
+	void ExportBakedLayouts();
+
+	// Saves type glue for the gathered classes and the module state the next incremental export compares against, and
+	// reports the modules this export skipped as up to date. Unlike FinishExport, no module glue or project files are written.
+	void ExportTypeGlue(TSet<FName>& OutUpToDateModules);
+
+	// incremental glue generation
+	void ComputeModuleInputHashes(const TArray<const UStruct*>& TypesToExport);
+	void GatherUpToDateModules(TSet<FName>& OutUpToDateModules);
+	void LoadGlueModuleStates();
+	void SaveGlueModuleStates() const;
 
-	void ExportClass(const UClass* Class);
-	void ExportStruct(const UScriptStruct* Struct);
+	// these return the type's glue, and must be safe to call from several threads at once
+	FString ExportClass(const UClass* Class, TArray<ExtensionMethod>& OutExtensionMethods) const;
+	FString ExportStruct(const UScriptStruct* Struct) const;
 
 	bool HasInjectedSource(const UStruct* StructOrClass) const;
 
@@ -74,20 +109,36 @@ private:
 
 	bool GetExtensionMethodInfo(ExtensionMethod& Info, UFunction& Function) const;
 
+	struct FMonoTypeGlue
+	{
+		const UStruct* Struct;
+		FString Glue;
+		TArray<ExtensionMethod> ExtensionMethods;
+	};
+
 	void ExportStaticConstructor(FMonoTextBuilder& Builder, 
 		const UStruct* Struct,
 		const TArray<UProperty*>& ExportedProperties,
 		const TArray<UFunction*>& ExportedFunction,
 		const TArray<UFunction*>& ExportedOverrideableFunctions,
 		const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters) const;
+	void ExportStaticConstructorBody(FMonoTextBuilder& Builder,
+		const UStruct* Struct,
+		const TArray<UProperty*>& ExportedProperties,
+		const TArray<UFunction*>& ExportedFunction,
+		const TArray<UFunction*>& ExportedOverrideableFunctions,
+		const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters,
+		bool bBakedLayout) const;
 
-	void ExportMirrorStructMarshalling(FMonoTextBuilder& Builder, const UScriptStruct* Struct, TArray<UProperty*> ExportedProperties);
-	void ExportStructMarshaler(FMonoTextBuilder& Builder, const UScriptStruct* Struct);
+	void ExportMirrorStructMarshalling(FMonoTextBuilder& Builder, const UScriptStruct* Struct, TArray<UProperty*> ExportedProperties) const;
+	void ExportStructMarshaler(FMonoTextBuilder& Builder, const UScriptStruct* Struct) const;
 
 	void GatherExportedProperties(TArray<UProperty*>& ExportedProperties, const UStruct* Struct) const;
 	void CollapseGettersAndSetters(TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, const UClass* Class, const TArray<UProperty*>& ExportedProperties, const TArray<UFunction*>& ExportedFunctions) const;
 	void ExportClassProperties(FMonoTextBuilder& Builder, const UClass* Class, TArray<UProperty*>& ExportedProperties, TSet<FString>& ExportedPropertiesHash) const;
-	void ExportPropertiesStaticConstruction(FMonoTextBuilder& Builder, const TArray<UProperty*>& ExportedProperties, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters) const;
+	void ExportPropertiesStaticConstruction(FMonoTextBuilder& Builder, const TArray<UProperty*>& ExportedProperties, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, bool bBakedLayout) const;
+	// Emits a local array holding the offset, property pointer and element sizes of Properties, looked up in one native call
+	void ExportNativePropertyInfosLookup(FMonoTextBuilder& Builder, const FString& InfosVariableName, const FString& NativeStructExpression, const TArray<UProperty*>& Properties) const;
 	void ExportStructProperties(FMonoTextBuilder& Builder, const UStruct* Struct, const TArray<UProperty*>& ExportedProperties, bool bSuppressOffsets) const;
 
 	void ExportClassCollapsedGettersAndSetters(FMonoTextBuilder& Builder, const UClass* Class, TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, TSet<FString>& ExportedPropertiesHash) const;
@@ -96,12 +147,16 @@ private:
 	void GatherExportedFunctions(TArray<UFunction*>& ExportedFunctions, const UStruct* Struct) const;
 	void GatherExportedOverridableFunctions(TArray<UFunction*>& ExportedFunctions, const UStruct* Struct) const;
 
-	void ExportClassFunctions(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions);
+	void ExportClassFunctions(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, TArray<ExtensionMethod>& OutExtensionMethods) const;
 	void ExportClassOverridableFunctions(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedOverridableFunctions) const;
 
-	void ExportClassFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters) const;
-	void ExportClassFunctionStaticConstruction(FMonoTextBuilder& Builder, const UFunction *Function) const;
-	void ExportClassOverridableFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedOverridableFunctions) const;
+	void ExportClassFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedFunctions, const TArray<FCollapsedGetterSetter>& CollapsedGettersAndSetters, bool bBakedLayout) const;
+	void ExportClassFunctionStaticConstruction(FMonoTextBuilder& Builder, const UFunction *Function, bool bBakedLayout) const;
+	void ExportFunctionParamsSizeStaticConstruction(FMonoTextBuilder& Builder, const UFunction* Function, const FString& NativeMethodName, bool bBakedLayout) const;
+	void ExportParametersStaticConstruction(FMonoTextBuilder& Builder, const UFunction* Function, const FString& NativeMethodName, bool bBakedLayout) const;
+	void ExportClassOverridableFunctionsStaticConstruction(FMonoTextBuilder& Builder, const UClass* Class, const TArray<UFunction*>& ExportedOverridableFunctions, bool bBakedLayout) const;
+
+	static FString GetBakedLayoutClassName(FName ModuleFName);
 
 	FString GetCSharpEnumType(const EPropertyType PropertyType) const;
 	void ExportEnums(FMonoTextBuilder& Builder, const TArray<UEnum*>& ExportedEnums) const;
@@ -118,6 +173,7 @@ private:
 	void SaveTypeGlue(const UStruct* Struct, const FString& GeneratedGlue);
 	void SaveModuleGlue(UPackage* Package, const FString& GeneratedGlue);
 	void SaveExtensionsGlue(const FMonoBindingsModule& Bindings, const FString& GeneratedGlue);
+	void SaveBakedLayoutGlue(const FMonoBindingsModule& Bindings, const FString& GeneratedGlue);
 
 	void GenerateProjectFiles();
 	void GenerateMSBuildPropsFile(const FString& PropsFilePath, const TArray<const FMonoProjectFile*>& Projects, const FString& AssemblyLocationVariable, bool bIncludeRuntime);
@@ -136,6 +192,39 @@ private:
 	// Is module registration open? (we can't do it until FinishExport)
 	bool		bModuleRegistrationOpen;
 
+	// Emit baked layout literals in static constructors
+	bool		bBakeNativeLayout;
+
+	// Modules with static constructors referencing a baked layout class
+	mutable TSet<FName> BakedLayoutModules;
+	mutable FCriticalSection BakedLayoutModulesLock;
+
+	// Generate type glue with ParallelFor
+	bool		bParallelGlueGeneration;
+
+	// Skip modules whose inputs match the last export
+	bool		bIncrementalGlueGeneration;
+
+	struct FGlueModuleState
+	{
+		uint32 InputHash;
+		bool bExportExtensions;
+		bool bExportBakedLayout;
+	};
+
+	// Module state from the last export, loaded from GlueModuleStatePath
+	TMap<FName, FGlueModuleState> PreviousGlueModuleStates;
+	FString		GlueModuleStatePath;
+
+	// Hash of each exported module's types and their references, for this export
+	TMap<FName, uint32> ModuleInputHashes;
+
+	// Modules with classes UHT reported as changed
+	TSet<FName> ModulesChangedByUHT;
+
+	// Modules the last incremental export skipped because their inputs were unchanged
+	TSet<FName> UpToDateModules;
+
 	// Modules we are exporting mono bindings for
 	TMap<FName, FMonoBindingsModule> MonoBindingsModules;
 
@@ -212,6 +301,9 @@ private:
 	mutable UnhandledPropertyCounts UnhandledReturnValues;
 	mutable UnhandledPropertyCounts UnhandledOverridableParameters;
 	mutable UnhandledPropertyCounts UnhandledOverridableReturnValues;
+	mutable FCriticalSection UnhandledPropertiesLock;
+
+	void CountUnhandledProperty(UnhandledPropertyCounts& Counts, const UProperty* Property) const;
 
 	FString GetAssemblyDirectory(const FString &RootDirectory, const EBuildConfigurations::Type Configuration, const FString &PlatformName, const FString &TargetName);
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Modules/ModuleManager.h"
 
 // mirrored from EdGraphSchema_K2.cpp (we can't bring in Kismet into a program plugin)
 const FName MD_IsBlueprintBase(TEXT("IsBlueprintBase"));
@@ -400,3 +402,147 @@ bool MonoScriptCodeGeneratorUtils::ParseGuidFromProjectFile(FGuid& ResultGuid, c
 
 	return FGuid::ParseExact(GuidString, EGuidFormats::DigitsWithHyphensInBraces, ResultGuid);
 }
+
+struct FTypeSignatureHasher
+{
+	uint32 Hash = 0;
+	TSet<const UStruct*> VisitedStructs;
+
+	void HashInt(int64 Value)
+	{
+		Hash = FCrc::MemCrc32(&Value, sizeof(Value), Hash);
+	}
+
+	void HashString(const FString& Value)
+	{
+		Hash = FCrc::StrCrc32(*Value, Hash);
+	}
+
+	void HashMetaData(const UObject& Object)
+	{
+		const TMap<FName, FString>* MetaDataMap = UMetaData::GetMapForObject(&Object);
+		if (nullptr == MetaDataMap)
+		{
+			HashInt(0);
+			return;
+		}
+
+		TArray<FName> Keys;
+		MetaDataMap->GetKeys(Keys);
+		Keys.Sort(FNameLexicalLess());
+
+		HashInt(Keys.Num());
+		for (FName Key : Keys)
+		{
+			HashString(Key.ToString());
+			HashString(MetaDataMap->FindChecked(Key));
+		}
+	}
+
+	void HashProperty(const UProperty& Property)
+	{
+		FString ExtendedType;
+		HashString(Property.GetName());
+		HashString(Property.GetClass()->GetName());
+		HashString(Property.GetCPPType(&ExtendedType, 0));
+		HashString(ExtendedType);
+		HashInt(static_cast<int64>(Property.PropertyFlags));
+		HashInt(Property.ArrayDim);
+		HashMetaData(Property);
+
+		// marshaling depends on the contents of nested structs (e.g. whether they are blittable), so hash them too
+		if (const UStructProperty* StructProperty = Cast<UStructProperty>(&Property))
+		{
+			HashStruct(*StructProperty->Struct);
+		}
+		else if (const UArrayProperty* ArrayProperty = Cast<UArrayProperty>(&Property))
+		{
+			HashProperty(*ArrayProperty->Inner);
+		}
+		else if (const USetProperty* SetProperty = Cast<USetProperty>(&Property))
+		{
+			HashProperty(*SetProperty->ElementProp);
+		}
+		else if (const UMapProperty* MapProperty = Cast<UMapProperty>(&Property))
+		{
+			HashProperty(*MapProperty->KeyProp);
+			HashProperty(*MapProperty->ValueProp);
+		}
+	}
+
+	void HashStruct(const UStruct& Struct)
+	{
+		HashString(Struct.GetPathName());
+
+		// a struct can refer to itself through a container
+		if (VisitedStructs.Contains(&Struct))
+		{
+			return;
+		}
+		VisitedStructs.Add(&Struct);
+
+		const UStruct* SuperStruct = Struct.GetSuperStruct();
+		HashString(SuperStruct ? SuperStruct->GetPathName() : FString());
+		HashInt(Struct.GetPropertiesSize());
+		HashInt(Struct.GetMinAlignment());
+
+		if (const UClass* Class = Cast<UClass>(&Struct))
+		{
+			HashInt(Class->ClassFlags);
+			for (const FImplementedInterface& Interface : Class->Interfaces)
+			{
+				HashString(Interface.Class ? Interface.Class->GetPathName() : FString());
+			}
+		}
+		else if (const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(&Struct))
+		{
+			HashInt(ScriptStruct->StructFlags);
+			HashInt(ScriptStruct->GetCppStructOps() ? ScriptStruct->GetCppStructOps()->GetSize() : 0);
+		}
+
+		HashMetaData(Struct);
+
+		for (TFieldIterator<UProperty> PropIt(&Struct, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+		{
+			HashProperty(**PropIt);
+		}
+
+		for (TFieldIterator<UFunction> FuncIt(&Struct, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+		{
+			HashString(FuncIt->GetName());
+			HashInt(FuncIt->FunctionFlags);
+			HashMetaData(**FuncIt);
+
+			for (TFieldIterator<UProperty> ParamIt(*FuncIt); ParamIt; ++ParamIt)
+			{
+				HashProperty(**ParamIt);
+			}
+		}
+	}
+};
+
+uint32 MonoScriptCodeGeneratorUtils::ComputeTypeSignatureHash(const UStruct& Struct)
+{
+	FTypeSignatureHasher Hasher;
+	Hasher.HashStruct(Struct);
+	return Hasher.Hash;
+}
+
+#if MONOUE_STANDALONE
+void MonoScriptCodeGeneratorUtils::GetStandaloneGeneratorPaths(FString& OutRootLocalPath, FString& OutOutputDirectory)
+{
+	// These paths are from .uhtmanifest
+	OutRootLocalPath = FPaths::Combine(*FPaths::EngineDir(), TEXT(".."));
+	FPaths::CollapseRelativeDirectories(OutRootLocalPath);
+
+	// OutputDirectory / IncludeBase are obtained from the module entry in .uhtmanifest (defined by GetGeneratedCodeModuleName which is "MonoRuntime")
+	// - The MonoUE generator doesn't currently use IncludeBase but does use OutputDirectory for the output code
+	FString PluginBaseDir = FPaths::GetPath(FModuleManager::Get().GetModuleFilename("MonoScriptGenerator"));
+	PluginBaseDir = FPaths::Combine(*PluginBaseDir, TEXT("../../"));
+	FPaths::CollapseRelativeDirectories(PluginBaseDir);
+
+	// I think this is where it normally goes?
+	OutOutputDirectory = FPaths::Combine(*PluginBaseDir, TEXT("Intermediate/Build/Win64/UE4Editor/Inc/MonoRuntime"));
+	FPaths::CollapseRelativeDirectories(OutOutputDirectory);
+}
+#endif
@@ -308,5 +308,15 @@ namespace MonoScriptCodeGeneratorUtils
 	bool IsBlueprintFunctionLibrary(const UClass* InClass);
 
 	bool ParseGuidFromProjectFile(FGuid& ResultGuid, const FString& ProjectPath);
+
+	// Hash of everything about a class or struct that its generated glue, or glue referencing it, depends on:
+	// flags, metadata, properties and function signatures, including the layout of nested struct properties.
+	// Not thread safe, since it reads package metadata.
+	uint32 ComputeTypeSignatureHash(const UStruct& Struct);
+
+#if MONOUE_STANDALONE
+	// Paths that would normally come from the .uhtmanifest, for running the generator inside the editor
+	void GetStandaloneGeneratorPaths(FString& OutRootLocalPath, FString& OutOutputDirectory);
+#endif
 }
 
@@ -102,27 +102,35 @@ void FMonoScriptGenerator::GenerateCode(const TArray<FString>& Args)
 	//    }]
 	//}
 
-	// These paths are from .uhtmanifest
-	FString RootLocalPath = FPaths::Combine(*FPaths::EngineDir(), TEXT(".."));
-	FPaths::CollapseRelativeDirectories(RootLocalPath);
-	
-	FString RootBuildPath = RootLocalPath;// This is just the same as RootLocalPath?	
-
-	// OutputDirectory / IncludeBase are obtained from the module entry in .uhtmanifest (defined by GetGeneratedCodeModuleName which is "MonoRuntime")
-	// - The MonoUE generator doesn't currently use IncludeBase but does use OutputDirectory for the output code
-	FString PluginBaseDir = FPaths::GetPath(FModuleManager::Get().GetModuleFilename("MonoScriptGenerator"));
-	PluginBaseDir = FPaths::Combine(*PluginBaseDir, TEXT("../../"));
-	FPaths::CollapseRelativeDirectories(PluginBaseDir);
-
-	// I think this is where it normally goes?
-	FString OutDir = FPaths::Combine(*PluginBaseDir, TEXT("Intermediate/Build/Win64/UE4Editor/Inc/MonoRuntime"));
-	FPaths::CollapseRelativeDirectories(OutDir);
+	FString RootLocalPath;
+	FString OutputDirectory;
+	MonoScriptCodeGeneratorUtils::GetStandaloneGeneratorPaths(RootLocalPath, OutputDirectory);
 
-	FString OutputDirectory = OutDir;
-	FString IncludeBase = OutDir;
+	FString RootBuildPath = RootLocalPath;// This is just the same as RootLocalPath?	
+	FString IncludeBase = OutputDirectory;
 
 	Initialize(RootLocalPath, RootBuildPath, OutputDirectory, IncludeBase);	
 
+	// Classes are linked in this process, so their offsets can be baked into the bindings.
+	// The bindings check a layout hash at runtime and fall back to dynamic lookups if it doesn't match.
+	bool bBakeLayout = false;
+	// Skip modules whose types, and the types they reference, are unchanged since the last MonoGen.
+	bool bIncremental = false;
+	for (const FString& Arg : Args)
+	{
+		if (Arg.Equals(TEXT("-BakeLayout"), ESearchCase::IgnoreCase))
+		{
+			bBakeLayout = true;
+		}
+		else if (Arg.Equals(TEXT("-Incremental"), ESearchCase::IgnoreCase))
+		{
+			bIncremental = true;
+		}
+	}
+	CodeGenerator->SetBakeNativeLayout(bBakeLayout);
+	// -MonoIncrementalGlue on the engine command line turns it on too
+	CodeGenerator->SetIncrementalGlueGeneration(bIncremental || CodeGenerator->IsIncrementalGlueGeneration());
+
 	// TODO: ModuleType info for modules doesn't appear to be available anywhere in the engine. Therefore we would need to search for all
 	//       .uplugin files and match them up to the loaded modules. Then use the "Type" to get the EBuildModuleType::Type from the json.
 	//       - I think UBT does this but UBT is written in C# so we would have to emulate this ourselves.
@@ -179,7 +187,7 @@ void FMonoScriptGenerator::StartupModule()
 #if MONOUE_STANDALONE
 	GenerateCodeCmd = IConsoleManager::Get().RegisterConsoleCommand(
 			TEXT("MonoGen"),
-			TEXT("MonoUE generate C# code"),
+			TEXT("MonoUE generate C# code. Pass -BakeLayout to emit property offsets as literals, -Incremental to only regenerate changed modules."),
 			FConsoleCommandWithArgsDelegate::CreateRaw(this, &FMonoScriptGenerator::GenerateCode),
 			ECVF_Default);
 #endif
@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+#include "MonoScriptCodeGenerator.h"
+#include "MonoScriptCodeGeneratorUtils.h"
+#include "MonoGeneratedFileManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+
+#if MONOUE_STANDALONE && WITH_DEV_AUTOMATION_TESTS
+
+// Gathers CoreUObject and Engine classes for export, reporting the Engine ones as changed by UHT if requested
+static void GatherCoreAndEngineClasses(FMonoScriptCodeGenerator& Generator, bool bEngineChanged)
+{
+	const FName CoreUObjectModule(TEXT("CoreUObject"));
+	const FName EngineModule(TEXT("Engine"));
+	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		const FName ModuleFName = MonoScriptCodeGeneratorUtils::GetModuleFName(**ClassIt);
+		if (ModuleFName == CoreUObjectModule || ModuleFName == EngineModule)
+		{
+			Generator.GatherClassForExport(*ClassIt, TEXT(""), TEXT(""), bEngineChanged && ModuleFName == EngineModule);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoScriptGeneratorParallelGlueTests, "MonoScriptGenerator.Parallel Glue Generation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMonoScriptGeneratorParallelGlueTests::RunTest(const FString& Parameters)
+{
+	FString RootLocalPath;
+	FString OutputDirectory;
+	MonoScriptCodeGeneratorUtils::GetStandaloneGeneratorPaths(RootLocalPath, OutputDirectory);
+
+	// a separate generator, so nothing is saved and the MonoGen command's state is untouched
+	FMonoScriptCodeGenerator Generator;
+	Generator.Initialize(RootLocalPath, RootLocalPath, OutputDirectory);
+
+	GatherCoreAndEngineClasses(Generator, false);
+
+	TArray<FString> MismatchedTypes;
+	TestTrue(TEXT("Found types to export"), Generator.VerifyParallelGlueGeneration(MismatchedTypes));
+
+	for (const FString& TypeName : MismatchedTypes)
+	{
+		AddError(FString::Printf(TEXT("Parallel glue for %s differs from serial glue"), *TypeName));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoScriptGeneratorIncrementalGlueTests, "MonoScriptGenerator.Incremental Glue Generation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMonoScriptGeneratorIncrementalGlueTests::RunTest(const FString& Parameters)
+{
+	FString RootLocalPath;
+	FString OutputDirectory;
+	MonoScriptCodeGeneratorUtils::GetStandaloneGeneratorPaths(RootLocalPath, OutputDirectory);
+
+	// glue and module state go three levels above the output directory, keep them out of the real bindings
+	const FString ScratchDirectory = FPaths::Combine(*FPaths::ProjectIntermediateDir(), TEXT("MonoScriptGeneratorTests"), TEXT("IncrementalGlue"));
+	const FString ScratchOutputDirectory = FPaths::Combine(*ScratchDirectory, TEXT("Test"), TEXT("UE4Editor"), TEXT("Inc"), TEXT("MonoRuntime"));
+	IFileManager::Get().DeleteDirectory(*ScratchDirectory, false, true);
+
+	// a full export leaves the state the incremental one compares against
+	{
+		FMonoScriptCodeGenerator Generator;
+		Generator.Initialize(RootLocalPath, RootLocalPath, ScratchOutputDirectory);
+		GatherCoreAndEngineClasses(Generator, false);
+
+		TSet<FName> UpToDateModules;
+		Generator.ExportTypeGlue(UpToDateModules);
+		TestEqual(TEXT("A full export skips nothing"), UpToDateModules.Num(), 0);
+	}
+
+	{
+		FMonoScriptCodeGenerator Generator;
+		Generator.Initialize(RootLocalPath, RootLocalPath, ScratchOutputDirectory);
+		Generator.SetIncrementalGlueGeneration(true);
+		GatherCoreAndEngineClasses(Generator, true);
+
+		TSet<FName> UpToDateModules;
+		Generator.ExportTypeGlue(UpToDateModules);
+		TestTrue(TEXT("Unchanged CoreUObject glue is skipped"), UpToDateModules.Contains(TEXT("CoreUObject")));
+		TestFalse(TEXT("Engine glue is regenerated after UHT reported a change"), UpToDateModules.Contains(TEXT("Engine")));
+	}
+
+	IFileManager::Get().DeleteDirectory(*ScratchDirectory, false, true);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoScriptGeneratorFileManagerTests, "MonoScriptGenerator.Generated File Hashes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMonoScriptGeneratorFileManagerTests::RunTest(const FString& Parameters)
+{
+	const FString ScratchDirectory = FPaths::Combine(*FPaths::ProjectIntermediateDir(), TEXT("MonoScriptGeneratorTests"), TEXT("GeneratedFileHashes"));
+	const FString ManifestPath = FPaths::Combine(*ScratchDirectory, TEXT("GeneratedFileHashes.json"));
+	const FString GluePath = FPaths::Combine(*ScratchDirectory, TEXT("Glue.cs"));
+	const FString StalePath = FPaths::Combine(*ScratchDirectory, TEXT("Stale.cs"));
+	const FString KeptPath = FPaths::Combine(*ScratchDirectory, TEXT("Kept.cs"));
+	IFileManager::Get().DeleteDirectory(*ScratchDirectory, false, true);
+	IFileManager::Get().MakeDirectory(*ScratchDirectory, true);
+
+	// first run writes everything and records it
+	{
+		FMonoGeneratedFileManager FileManager;
+		FileManager.LoadHashManifest(ManifestPath);
+		FileManager.SaveFileIfChanged(GluePath, TEXT("class Glue {}"));
+		FileManager.SaveFileIfChanged(StalePath, TEXT("class Stale {}"));
+		FileManager.SaveFileIfChanged(KeptPath, TEXT("class Kept {}"));
+		TestEqual(TEXT("First run writes every file"), FileManager.TempFiles.Num(), 3);
+		FileManager.RenameTempFiles();
+		FileManager.PruneHashManifest();
+		TestEqual(TEXT("First run records every file"), FileManager.HashManifest.Num(), 3);
+	}
+
+	// same contents again: nothing is written, Stale.cs is no longer generated and Kept.cs is skipped by the caller
+	{
+		FMonoGeneratedFileManager FileManager;
+		FileManager.LoadHashManifest(ManifestPath);
+		TestEqual(TEXT("Manifest is loaded"), FileManager.HashManifest.Num(), 3);
+		FileManager.SaveFileIfChanged(GluePath, TEXT("class Glue {}"));
+		FileManager.KeepFile(KeptPath);
+		TestEqual(TEXT("Regenerating unchanged contents writes nothing"), FileManager.TempFiles.Num(), 0);
+		FileManager.RenameTempFiles();
+		FileManager.PruneHashManifest();
+		TestTrue(TEXT("Saved file keeps its hash"), FileManager.HashManifest.Contains(GluePath));
+		TestTrue(TEXT("Kept file keeps its hash"), FileManager.HashManifest.Contains(KeptPath));
+		TestFalse(TEXT("File that is no longer generated is pruned"), FileManager.HashManifest.Contains(StalePath));
+	}
+
+	// changed contents are written
+	{
+		FMonoGeneratedFileManager FileManager;
+		FileManager.LoadHashManifest(ManifestPath);
+		TestEqual(TEXT("Pruned manifest is saved"), FileManager.HashManifest.Num(), 2);
+		FileManager.SaveFileIfChanged(GluePath, TEXT("class Glue { int X; }"));
+		TestEqual(TEXT("Changed contents are written"), FileManager.TempFiles.Num(), 1);
+	}
+
+	FString GlueContents;
+	FFileHelper::LoadFileToString(GlueContents, *GluePath);
+	TestEqual(TEXT("Changed contents are on disk"), GlueContents, FString(TEXT("class Glue { int X; }")));
+
+	IFileManager::Get().DeleteDirectory(*ScratchDirectory, false, true);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMonoScriptGeneratorBakedLayoutTests, "MonoScriptGenerator.Baked Layout Glue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMonoScriptGeneratorBakedLayoutTests::RunTest(const FString& Parameters)
+{
+	FString RootLocalPath;
+	FString OutputDirectory;
+	MonoScriptCodeGeneratorUtils::GetStandaloneGeneratorPaths(RootLocalPath, OutputDirectory);
+
+	// a separate generator, so nothing is saved and the MonoGen command's state is untouched
+	FMonoScriptCodeGenerator Generator;
+	Generator.Initialize(RootLocalPath, RootLocalPath, OutputDirectory);
+	Generator.SetBakeNativeLayout(true);
+	GatherCoreAndEngineClasses(Generator, false);
+
+	Generator.bModuleRegistrationOpen = true;
+	TArray<const UStruct*> TypesToExport;
+	Generator.GatherTypesToExport(TypesToExport);
+
+	UClass* ActorClass = FindObject<UClass>(ANY_PACKAGE, TEXT("Actor"));
+	check(ActorClass);
+	TArray<const UStruct*> KnownTypes;
+	KnownTypes.Add(ActorClass);
+	TArray<FMonoScriptCodeGenerator::FMonoTypeGlue> TypeGlue;
+	Generator.GenerateTypeGlue(KnownTypes, TypeGlue, false);
+	check(TypeGlue.Num() == 1);
+
+	// the static constructor assigns literal offsets when the baked layout is valid, and looks them up otherwise
+	TArray<FString> Lines;
+	TypeGlue[0].Glue.ParseIntoArrayLines(Lines);
+	TMap<FString, int32> BakedOffsets;
+	TSet<FString> LookedUpOffsets;
+	bool bInBakedBranch = false;
+	bool bInFallbackBranch = false;
+	for (const FString& Line : Lines)
+	{
+		const FString Trimmed = Line.TrimStartAndEnd();
+		if (!bInBakedBranch && !bInFallbackBranch && Trimmed.StartsWith(TEXT("if (")) && Trimmed.EndsWith(TEXT("BakedLayout.IsValid)")))
+		{
+			bInBakedBranch = true;
+			continue;
+		}
+		if (bInBakedBranch && Trimmed == TEXT("else"))
+		{
+			bInBakedBranch = false;
+			bInFallbackBranch = true;
+			continue;
+		}
+
+		FString Name;
+		FString Value;
+		if ((bInBakedBranch || bInFallbackBranch) && Trimmed.Split(TEXT("_Offset = "), &Name, &Value) && Value.RemoveFromEnd(TEXT(";")))
+		{
+			if (bInBakedBranch && Value.IsNumeric())
+			{
+				BakedOffsets.Add(Name, FCString::Atoi(*Value));
+			}
+			else if (bInFallbackBranch)
+			{
+				LookedUpOffsets.Add(Name);
+			}
+		}
+	}
+
+	int32 NumChecked = 0;
+	auto CheckBakedOffset = [this, &BakedOffsets, &LookedUpOffsets, &NumChecked](const FString& Name, const UProperty& Property)
+	{
+		const int32* BakedOffset = BakedOffsets.Find(Name);
+		if (nullptr != BakedOffset)
+		{
+			TestEqual(FString::Printf(TEXT("Baked offset of %s"), *Property.GetPathName()), *BakedOffset, Property.GetOffset_ForInternal());
+			TestTrue(FString::Printf(TEXT("Offset of %s is looked up when the baked layout is invalid"), *Property.GetPathName()), LookedUpOffsets.Contains(Name));
+			++NumChecked;
+		}
+	};
+
+	for (TFieldIterator<UProperty> PropIt(ActorClass, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+	{
+		CheckBakedOffset(PropIt->GetName(), **PropIt);
+	}
+	for (TFieldIterator<UFunction> FuncIt(ActorClass, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+	{
+		for (TFieldIterator<UProperty> ParamIt(*FuncIt); ParamIt; ++ParamIt)
+		{
+			CheckBakedOffset(FuncIt->GetName() + TEXT("_") + ParamIt->GetName(), **ParamIt);
+		}
+	}
+
+	TestTrue(TEXT("Found baked offsets in the Actor glue"), NumChecked > 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation.  All Rights Reserved.
+// See LICENSE.txt in the plugin root for license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+
+namespace MonoAssemblyProcess
+{
+    // Writes assembly metadata in the compact binary form the runtime prefers over the json sidecar.
+    // The layout is a header, a table of unique UTF-16 strings, then the records in the same order the runtime's
+    // json parser reads fields, with strings stored as indices into the table (-1 for null).
+    // Keep in sync with FMonoMetadataBinaryReader in MonoAssemblyMetadata.cpp.
+    class BinaryMetadataWriter
+    {
+        const uint Magic = 0x4D45554D; // "MUEM"
+        const uint Version = 3;
+
+        readonly Dictionary<string, int> StringIndices = new Dictionary<string, int>();
+        readonly List<string> Strings = new List<string>();
+        readonly BinaryWriter Body;
+
+        BinaryMetadataWriter(BinaryWriter body)
+        {
+            Body = body;
+        }
+
+        public static void Write(AssemblyMetadata metadata, string path)
+        {
+            using (var bodyStream = new MemoryStream())
+            using (var bodyWriter = new BinaryWriter(bodyStream))
+            {
+                var writer = new BinaryMetadataWriter(bodyWriter);
+                writer.WriteAssembly(metadata);
+                bodyWriter.Flush();
+
+                using (var file = new BinaryWriter(File.Create(path)))
+                {
+                    file.Write(Magic);
+                    file.Write(Version);
+                    file.Write(writer.Strings.Count);
+                    foreach (var str in writer.Strings)
+                    {
+                        file.Write(str.Length);
+                        file.Write(Encoding.Unicode.GetBytes(str));
+                    }
+                    bodyStream.WriteTo(file.BaseStream);
+                }
+            }
+        }
+
+        void WriteString(string value)
+        {
+            if (value == null)
+            {
+                Body.Write(-1);
+                return;
+            }
+
+            int index;
+            if (!StringIndices.TryGetValue(value, out index))
+            {
+                index = Strings.Count;
+                Strings.Add(value);
+                StringIndices.Add(value, index);
+            }
+            Body.Write(index);
+        }
+
+        void WriteBool(bool value)
+        {
+            Body.Write((byte)(value ? 1 : 0));
+        }
+
+        void WriteArray<T>(ICollection<T> items, Action<T> writeItem)
+        {
+            if (items == null)
+            {
+                Body.Write(0);
+                return;
+            }
+
+            Body.Write(items.Count);
+            foreach (var item in items)
+            {
+                writeItem(item);
+            }
+        }
+
+        // UnrealType subclasses don't share a base for these, the json serializer finds them by name too
+        static T GetField<T>(object obj, string fieldName)
+        {
+            FieldInfo field = obj.GetType().GetField(fieldName, BindingFlags.Public | BindingFlags.Instance);
+            if (field == null)
+            {
+                throw new InvalidOperationException(String.Format("{0} has no field {1}", obj.GetType().Name, fieldName));
+            }
+            return (T)field.GetValue(obj);
+        }
+
+        void WriteAssembly(AssemblyMetadata metadata)
+        {
+            WriteString(metadata.AssemblyName);
+            WriteString(metadata.AssemblyPath);
+            WriteArray(metadata.References, WriteAssemblyReference);
+            WriteArray(metadata.Structs, WriteStruct);
+            WriteArray(metadata.Classes, WriteClass);
+            WriteArray(metadata.Enums, WriteEnum);
+        }
+
+        void WriteAssemblyReference(AssemblyReferenceMetadata reference)
+        {
+            WriteString(reference.AssemblyName);
+            WriteString(reference.AssemblyPath);
+            WriteBool(reference.Resolved);
+            WriteBool(reference.InKnownLocation);
+        }
+
+        void WriteTypeReference(TypeReferenceMetadata typeRef)
+        {
+            WriteString(typeRef.Namespace);
+            WriteString(typeRef.Name);
+            WriteString(typeRef.AssemblyName);
+        }
+
+        void WriteKeyValuePairs(KeyValuePairMetadata[] pairs)
+        {
+            WriteArray(pairs, pair =>
+            {
+                WriteString(pair.Key);
+                WriteString(pair.Value);
+            });
+        }
+
+        void WriteMetadataBase(string name, AccessModifier protection, KeyValuePairMetadata[] metadata)
+        {
+            WriteString(name);
+            Body.Write((byte)protection);
+            WriteKeyValuePairs(metadata);
+        }
+
+        void WriteUnrealType(UnrealType type)
+        {
+            WriteString(type.UnrealPropertyClass);
+            Body.Write(type.ArrayDim);
+
+            // must match the property classes FMonoUnrealType::ParseDerivedFromBinary handles
+            switch (type.UnrealPropertyClass)
+            {
+                case "EnumProperty":
+                    WriteString(GetField<string>(type, "NativeClassOwner"));
+                    WriteString(GetField<string>(type, "NativeEnumName"));
+                    WriteTypeReference(GetField<TypeReferenceMetadata>(type, "TypeRef"));
+                    break;
+                case "CoreStructProperty":
+                    WriteString(GetField<string>(type, "StructName"));
+                    break;
+                case "StructProperty":
+                    WriteString(GetField<string>(type, "NativeClassOwner"));
+                    WriteTypeReference(GetField<TypeReferenceMetadata>(type, "TypeRef"));
+                    break;
+                case "ObjectProperty":
+                case "ClassProperty":
+                case "WeakObjectProperty":
+                    WriteTypeReference(GetField<TypeReferenceMetadata>(type, "TypeRef"));
+                    break;
+                case "ArrayProperty":
+                    WriteProperty(GetField<PropertyMetadata>(type, "InnerProperty"));
+                    break;
+            }
+        }
+
+        void WriteProperty(PropertyMetadata property)
+        {
+            WriteMetadataBase(property.Name, property.Protection, property.Metadata);
+            WriteUnrealType(property.UnrealPropertyType);
+            WriteString(property.Flags);
+            WriteString(property.RepNotifyFunctionName);
+        }
+
+        void WriteFunction(FunctionMetadata function)
+        {
+            WriteMetadataBase(function.Name, function.Protection, function.Metadata);
+            WriteBool(function.ReturnValueProperty != null);
+            if (function.ReturnValueProperty != null)
+            {
+                WriteProperty(function.ReturnValueProperty);
+            }
+            WriteArray(function.ParamProperties, WriteProperty);
+            WriteString(function.Flags);
+        }
+
+        void WriteStruct(StructMetadata structMetadata)
+        {
+            WriteTypeReference(structMetadata);
+            WriteArray(structMetadata.Properties, WriteProperty);
+            WriteString(structMetadata.Flags);
+            WriteString(structMetadata.StructHash);
+        }
+
+        void WriteClass(ClassMetadata classMetadata)
+        {
+            WriteTypeReference(classMetadata);
+            WriteArray(classMetadata.VirtualFunctions, WriteString);
+            WriteArray(classMetadata.Properties, WriteProperty);
+            WriteArray(classMetadata.Functions, WriteFunction);
+            WriteTypeReference(classMetadata.BaseClass);
+            WriteTypeReference(classMetadata.BaseUnrealNativeClass);
+            WriteBool(classMetadata.ChildCanTick);
+            WriteBool(classMetadata.OverridesBindInput);
+            WriteString(classMetadata.ClassHash);
+            WriteString(classMetadata.BlueprintUse);
+            WriteString(classMetadata.Transience);
+            WriteString(classMetadata.Placeablity);
+            WriteBool(classMetadata.Deprecated);
+            WriteBool(classMetadata.Abstract);
+            WriteString(classMetadata.Group);
+            WriteString(classMetadata.ConfigFile);
+            WriteString(classMetadata.Flags);
+        }
+
+        void WriteEnum(EnumMetadata enumMetadata)
+        {
+            WriteTypeReference(enumMetadata);
+            WriteArray(enumMetadata.Items, WriteString);
+            WriteString(enumMetadata.EnumHash);
+            WriteBool(enumMetadata.BlueprintVisible);
+        }
+    }
+}
@@ -611,6 +611,7 @@ namespace MonoAssemblyProcess
             string pdbFile = Path.ChangeExtension (assemblyPath, ".pdb");
             string backupPdbFile = Path.ChangeExtension (pdbFile, ".bak.pdb");
             string metadataFileName = Path.ChangeExtension (assemblyPath, "json");
+            string binaryMetadataFileName = Path.ChangeExtension (assemblyPath, "metadata");
 
             // before we rewrite, copy the original assembly to a backup location
             // if we're debugging we might be using backup files directly, don't do the copy
@@ -645,6 +646,9 @@ namespace MonoAssemblyProcess
                     if (File.Exists (metadataFileName)) {
                         File.Delete (metadataFileName);
                     }
+                    if (File.Exists (binaryMetadataFileName)) {
+                        File.Delete (binaryMetadataFileName);
+                    }
                 }
                 return false;
             } catch (Exception e) {
@@ -663,6 +667,9 @@ namespace MonoAssemblyProcess
                     if (File.Exists (metadataFileName)) {
                         File.Delete (metadataFileName);
                     }
+                    if (File.Exists (binaryMetadataFileName)) {
+                        File.Delete (binaryMetadataFileName);
+                    }
                 }
                 return false;
             }
@@ -672,6 +679,7 @@ namespace MonoAssemblyProcess
         static void ProcessAssembly (AssemblyDefinition bindingsAssembly, string assemblyPath, string outputPath, BaseAssemblyResolver resolver, string [] knownPaths, NativeTypeManifest manifest, bool verify)
         {
             string metadataFileName = Path.ChangeExtension (outputPath, "json");
+            string binaryMetadataFileName = Path.ChangeExtension (outputPath, "metadata");
 
             var readerParams = new ReaderParameters {
                 AssemblyResolver = resolver,
@@ -830,8 +838,12 @@ namespace MonoAssemblyProcess
 
                 string metadataContents = fastJSON.JSON.ToNiceJSON (metadata, new fastJSON.JSONParameters { UseExtensions = false });
                 File.WriteAllText (metadataFileName, metadataContents);
+
+                // the runtime prefers this over the json, which stays around as the readable/fallback copy
+                BinaryMetadataWriter.Write (metadata, binaryMetadataFileName);
             } else {
                 File.Delete (metadataFileName);
+                File.Delete (binaryMetadataFileName);
             }
 
         }